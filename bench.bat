@@ -0,0 +1,42 @@
+@echo off
+REM Build benchmark (folder bench\) ke output\, terpisah dari main.exe
+REM Jalankan dari root project (MSYS2 UCRT64)
+
+echo ============================================
+echo Comic Management System - Benchmark Build
+echo ============================================
+echo.
+
+if not exist output mkdir output
+
+echo [1/3] Compiling bench_bst.cpp...
+g++ -std=c++11 -O2 -I include bench/bench_bst.cpp -o output/bench_bst.exe
+if errorlevel 1 (
+    echo ERROR: Failed to compile bench_bst.cpp
+    pause
+    exit /b 1
+)
+
+echo [2/3] Compiling bench_search.cpp...
+g++ -std=c++11 -O2 -I include bench/bench_search.cpp -o output/bench_search.exe -lsqlite3
+if errorlevel 1 (
+    echo ERROR: Failed to compile bench_search.cpp
+    pause
+    exit /b 1
+)
+
+echo [3/3] Compiling bench_db.cpp...
+g++ -std=c++11 -O2 -I include bench/bench_db.cpp -o output/bench_db.exe -lsqlite3
+if errorlevel 1 (
+    echo ERROR: Failed to compile bench_db.cpp
+    pause
+    exit /b 1
+)
+
+echo.
+echo Build completed! Contoh:
+echo   output\bench_bst.exe --sizes 1000,100000,1000000 --check-alloc --json bench_bst.json
+echo   output\bench_search.exe --comics 100000 --queries 300 --json bench_search.json
+echo   output\bench_db.exe --ops 500 --journal delete,wal --sync full,normal --batch 1,100 --json bench_db.json
+echo.
+pause
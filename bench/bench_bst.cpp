@@ -0,0 +1,353 @@
+/*
+ * bench_bst.cpp
+ * Micro-benchmark operasi BST: insert (random / sorted), search, update
+ * (ganti title), remove, searchPartial, count, getAllKomiks, traversal.
+ * Laporan: ns/op, alokasi/op, byte/op (AllocTracker), tinggi tree dan rata-rata depth
+ * (BST::shape), plus estimasi memory per node (MemoryReport) setelah insert_random.
+ * Opsi --json untuk regression tracking, --check-alloc untuk gagal (exit 1) kalau
+ * search / traversal melebihi budget alokasi.
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 -I include bench/bench_bst.cpp -o bench_bst
+ * Jalankan:
+ *   ./bench_bst [--sizes 1000,100000,1000000] [--json hasil.json] [--check-alloc]
+ */
+
+// Hook operator new/delete dipasang khusus untuk benchmark ini
+#define KOMIK_TRACK_ALLOC
+
+#include "../include/BST.h"
+#include "../src/BST.cpp"
+#include "../src/TableRenderer.cpp"
+#include "../src/MemoryReport.cpp"
+#include "../src/Metrics.cpp"
+#include "../src/AllocTracker.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Insert sorted membuat tree jadi linked list (tinggi = n, rekursi sedalam n)
+const size_t SORTED_INSERT_LIMIT = 10000;
+
+struct BenchResult
+{
+    string name;
+    size_t size;
+    size_t ops;
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+    int height;
+    double averageDepth;
+    bool skipped;
+};
+
+// Estimasi memory tree setelah insert_random (MemoryReport)
+struct MemoryResult
+{
+    size_t size;
+    size_t bytes;
+    double bytesPerNode;
+    size_t heapStrings;
+    size_t inlineStrings;
+};
+
+static string makeTitle(size_t i)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "Komik Legenda %08zu", i);
+    return buffer;
+}
+
+static const char *AUTHORS[] = {"Eiichiro Oda", "Masashi Kishimoto", "Akira Toriyama", "Gege Akutami", "Tite Kubo"};
+static const char *GENRES[] = {"Action", "Adventure", "Comedy", "Drama", "Fantasy", "Horror", "Romance", "Sci-Fi"};
+
+static Komik *makeKomik(size_t i)
+{
+    return new Komik((int)i + 1, makeTitle(i), AUTHORS[i % 5], string(GENRES[i % 8]) + ", " + GENRES[(i / 8) % 8]);
+}
+
+// ===== ALLOCATION BUDGET =====
+// Budget alokasi per op untuk search dan traversal. Hanya vector hasil yang
+// boleh tumbuh; perbandingan title tidak boleh copy string.
+// Slack kecil untuk registrasi slot metric di call pertama.
+const unsigned long long ALLOC_BUDGET_SLACK = 8;
+static bool checkAlloc = false;
+static int allocBudgetFailures = 0;
+
+static bool allocBudgetPerOp(const string &name, size_t size, double &perOp)
+{
+    // Vector hasil tumbuh 1, 2, 4, ... sampai >= size: ceil(log2(size)) + 1 alokasi
+    size_t growth = 1;
+    while (((size_t)1 << (growth - 1)) < size)
+        growth++;
+
+    if (name == "search" || name == "count" || name == "preOrder" || name == "inOrder" || name == "postOrder")
+        perOp = 0;
+    else if (name == "searchPartial" || name == "getAllKomiks")
+        perOp = (double)growth;
+    else
+        return false;
+    return true;
+}
+
+// Jalankan fn sebanyak ops kali (fn sendiri yang loop), catat waktu + alokasi
+template <typename Fn>
+static BenchResult measure(const string &name, size_t size, size_t ops, const BST *tree, Fn fn)
+{
+    AllocScope scope;
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto end = chrono::steady_clock::now();
+    AllocStats allocs = scope.delta();
+
+    double perOp;
+    if (checkAlloc && allocBudgetPerOp(name, size, perOp))
+    {
+        char label[64];
+        snprintf(label, sizeof(label), "%s (n=%zu)", name.c_str(), size);
+        if (!scope.withinBudget(label, (unsigned long long)(perOp * ops) + ALLOC_BUDGET_SLACK))
+            allocBudgetFailures++;
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.size = size;
+    result.ops = ops;
+    result.nsPerOp = chrono::duration<double, nano>(end - start).count() / (ops ? ops : 1);
+    result.allocsPerOp = (double)allocs.allocations / (ops ? ops : 1);
+    result.bytesPerOp = (double)allocs.bytes / (ops ? ops : 1);
+    TreeShape shape = tree ? tree->shape() : TreeShape();
+    result.height = shape.height;
+    result.averageDepth = shape.averageDepth;
+    result.skipped = false;
+    return result;
+}
+
+static void runSize(size_t n, vector<BenchResult> &results, vector<MemoryResult> &memory)
+{
+    mt19937 rng(42);
+    vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++)
+        order[i] = i;
+    shuffle(order.begin(), order.end(), rng);
+
+    // Node disiapkan dulu supaya insert hanya mengukur operasi tree
+    vector<Komik *> nodes;
+    nodes.reserve(n);
+    for (size_t i : order)
+        nodes.push_back(makeKomik(i));
+
+    BST tree;
+    results.push_back(measure("insert_random", n, n, &tree, [&]()
+                              {
+        for (Komik *node : nodes)
+            tree.insert(node); }));
+
+    MemoryReport report;
+    tree.accountMemory(report);
+    MemoryResult usage = {n, report.totalBytes(), (double)report.totalBytes() / (n ? n : 1), report.getHeapStrings(),
+                          report.getInlineStrings()};
+    memory.push_back(usage);
+
+    // Insert sorted hanya untuk ukuran kecil
+    if (n <= SORTED_INSERT_LIMIT)
+    {
+        vector<Komik *> sortedNodes;
+        for (size_t i = 0; i < n; i++)
+            sortedNodes.push_back(makeKomik(i));
+
+        BST sortedTree;
+        results.push_back(measure("insert_sorted", n, n, &sortedTree, [&]()
+                                  {
+            for (Komik *node : sortedNodes)
+                sortedTree.insert(node); }));
+    }
+    else
+    {
+        BenchResult skipped = {"insert_sorted", n, 0, 0, 0, 0, 0, 0, true};
+        results.push_back(skipped);
+    }
+
+    // Search: semua title dalam urutan acak
+    vector<string> titles;
+    titles.reserve(n);
+    for (size_t i : order)
+        titles.push_back(makeTitle(i));
+    shuffle(titles.begin(), titles.end(), rng);
+
+    size_t found = 0;
+    results.push_back(measure("search", n, n, &tree, [&]()
+                              {
+        for (const string &title : titles)
+            found += tree.search(title) != nullptr; }));
+
+    // Full traversal: jumlah pemanggilan dibatasi supaya ukuran besar tetap cepat
+    size_t scans = n >= 1000000 ? 3 : (n >= 100000 ? 10 : 200);
+
+    size_t hits = 0;
+    results.push_back(measure("searchPartial", n, scans, &tree, [&]()
+                              {
+        for (size_t i = 0; i < scans; i++)
+            hits += tree.searchPartial(i % 2 ? "legenda 0001" : "99").size(); }));
+
+    long long total = 0;
+    results.push_back(measure("count", n, scans, &tree, [&]()
+                              {
+        for (size_t i = 0; i < scans; i++)
+            total += tree.count(); }));
+
+    results.push_back(measure("getAllKomiks", n, scans, &tree, [&]()
+                              {
+        for (size_t i = 0; i < scans; i++)
+            total += tree.getAllKomiks().size(); }));
+
+    results.push_back(measure("preOrder", n, scans, &tree, [&]()
+                              {
+        for (size_t i = 0; i < scans; i++)
+            tree.preOrder([&total](Komik *k) { total += k->id; }); }));
+
+    results.push_back(measure("inOrder", n, scans, &tree, [&]()
+                              {
+        for (size_t i = 0; i < scans; i++)
+            tree.inOrder([&total](Komik *k) { total += k->id; }); }));
+
+    results.push_back(measure("postOrder", n, scans, &tree, [&]()
+                              {
+        for (size_t i = 0; i < scans; i++)
+            tree.postOrder([&total](Komik *k) { total += k->id; }); }));
+
+    // Update dengan ganti title (remove + insert) lalu remove title lain,
+    // masing-masing maksimal 10k op. Title baru tetap tersebar acak di tree.
+    size_t mutations = min(n / 2, (size_t)10000);
+
+    vector<Komik *> replacements;
+    for (size_t i = 0; i < mutations; i++)
+    {
+        replacements.push_back(new Komik((int)(n + i + 1), titles[i] + " v2", AUTHORS[i % 5], GENRES[i % 8]));
+    }
+
+    results.push_back(measure("update_title_change", n, mutations, &tree, [&]()
+                              {
+        for (size_t i = 0; i < mutations; i++)
+            tree.update(titles[i], replacements[i]); }));
+
+    results.push_back(measure("remove", n, mutations, &tree, [&]()
+                              {
+        for (size_t i = mutations; i < 2 * mutations; i++)
+            tree.remove(titles[i]); }));
+
+    // Cegah optimizer membuang loop
+    if (found + hits + total == 42)
+        printf(" ");
+}
+
+static vector<size_t> parseSizes(const string &list)
+{
+    vector<size_t> sizes;
+    stringstream ss(list);
+    string item;
+    while (getline(ss, item, ','))
+    {
+        if (!item.empty())
+            sizes.push_back(strtoull(item.c_str(), nullptr, 10));
+    }
+    return sizes;
+}
+
+int main(int argc, char *argv[])
+{
+    vector<size_t> sizes;
+    sizes.push_back(1000);
+    sizes.push_back(100000);
+    sizes.push_back(1000000);
+    string jsonPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc)
+            sizes = parseSizes(argv[++i]);
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (arg == "--check-alloc")
+            checkAlloc = true;
+    }
+
+    vector<BenchResult> results;
+    vector<MemoryResult> memory;
+    for (size_t n : sizes)
+        runSize(n, results, memory);
+
+    printf("%-22s %10s %10s %14s %12s %12s %8s %10s\n", "benchmark", "size", "ops", "ns/op", "allocs/op", "bytes/op",
+           "height", "avg depth");
+    for (const BenchResult &r : results)
+    {
+        if (r.skipped)
+        {
+            printf("%-22s %10zu %10s %14s %12s %12s %8s %10s\n", r.name.c_str(), r.size, "-", "skipped", "-", "-", "-",
+                   "-");
+            continue;
+        }
+        printf("%-22s %10zu %10zu %14.1f %12.2f %12.1f %8d %10.2f\n", r.name.c_str(), r.size, r.ops, r.nsPerOp,
+               r.allocsPerOp, r.bytesPerOp, r.height, r.averageDepth);
+    }
+
+    printf("\n%-22s %10s %14s %12s %12s %12s\n", "memory", "size", "bytes", "bytes/node", "heap str", "inline str");
+    for (const MemoryResult &m : memory)
+    {
+        printf("%-22s %10zu %14zu %12.1f %12zu %12zu\n", "tree_after_insert", m.size, m.bytes, m.bytesPerNode,
+               m.heapStrings, m.inlineStrings);
+    }
+
+    if (!jsonPath.empty())
+    {
+        FILE *out = fopen(jsonPath.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+            return 1;
+        }
+
+        fprintf(out, "{\n  \"benchmark\": \"bst\",\n  \"results\": [\n");
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const BenchResult &r = results[i];
+            fprintf(out, "    {\"name\": \"%s\", \"size\": %zu, \"ops\": %zu, \"ns_per_op\": %.1f, "
+                         "\"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f, \"height\": %d, \"avg_depth\": %.2f, "
+                         "\"skipped\": %s}%s\n",
+                    r.name.c_str(), r.size, r.ops, r.nsPerOp, r.allocsPerOp, r.bytesPerOp, r.height, r.averageDepth,
+                    r.skipped ? "true" : "false", i + 1 < results.size() ? "," : "");
+        }
+        fprintf(out, "  ],\n  \"memory\": [\n");
+        for (size_t i = 0; i < memory.size(); i++)
+        {
+            const MemoryResult &m = memory[i];
+            fprintf(out, "    {\"size\": %zu, \"bytes\": %zu, \"bytes_per_node\": %.1f, \"heap_strings\": %zu, "
+                         "\"inline_strings\": %zu}%s\n",
+                    m.size, m.bytes, m.bytesPerNode, m.heapStrings, m.inlineStrings, i + 1 < memory.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+        fclose(out);
+    }
+
+    if (checkAlloc)
+    {
+        if (allocBudgetFailures > 0)
+        {
+            fprintf(stderr, "%d benchmark melebihi budget alokasi\n", allocBudgetFailures);
+            return 1;
+        }
+        printf("\nAlloc budget: OK\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,404 @@
+/*
+ * bench_db.cpp
+ * Benchmark layer Database: setiap method (CRUD komik/genre/author/user,
+ * favorites, query read) dijalankan di beberapa kombinasi journal_mode,
+ * synchronous, dan ukuran batch (jumlah op per transaction; 1 = autocommit
+ * per row seperti pemakaian sekarang). Laporan: ops/detik, latency
+ * p50/p99/max per method, dan histogram latency (bucket pangkat 2, us).
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 -I include bench/bench_db.cpp -o bench_db -lsqlite3 -lpthread
+ * Jalankan:
+ *   ./bench_db [--ops 500] [--journal delete,wal] [--sync full,normal]
+ *              [--batch 1,100] [--db bench_db.db] [--histogram] [--json hasil.json]
+ *
+ * File --db dihapus dan dibuat ulang untuk setiap kombinasi.
+ */
+
+#include "../include/Database.h"
+#include "../include/Auth.h"
+#include "../src/SlowQueryLog.cpp"
+#include "../src/WriteBehindQueue.cpp"
+#include "../src/Database.cpp"
+#include "../src/Metrics.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Bucket ke-b = latency < 2^b us (bucket terakhir = sisanya)
+const int HISTOGRAM_BUCKETS = 22;
+
+struct MethodResult
+{
+    string journal;
+    string sync;
+    int batch;
+    string method;
+    vector<double> latencyUs;
+    double totalUs;
+    int failures;
+    unsigned long long histogram[HISTOGRAM_BUCKETS];
+
+    MethodResult() : batch(1), totalUs(0), failures(0)
+    {
+        fill(histogram, histogram + HISTOGRAM_BUCKETS, 0ULL);
+    }
+};
+
+struct RunConfig
+{
+    string journal;
+    string sync;
+    int batch;
+    int ops;
+    string path;
+};
+
+static int bucketOf(double us)
+{
+    int bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && us >= (double)(1ULL << bucket))
+        bucket++;
+    return bucket;
+}
+
+static double percentile(const vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+static string numbered(const char *prefix, int i)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%s %06d", prefix, i);
+    return buffer;
+}
+
+// Jalankan op(i) untuk i = 0..count-1. Setiap `batch` op dibungkus satu
+// transaction; waktu COMMIT dihitung ke op terakhir di batch itu (tail
+// latency memperlihatkan biaya fsync). batch <= 1 = autocommit.
+static void measure(Database &db, const RunConfig &config, const string &method, int count, int batch,
+                    const function<bool(int)> &op, vector<MethodResult> &results)
+{
+    MethodResult result;
+    result.journal = config.journal;
+    result.sync = config.sync;
+    result.batch = config.batch;
+    result.method = method;
+    result.latencyUs.reserve(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        auto start = chrono::steady_clock::now();
+
+        if (batch > 1 && i % batch == 0)
+            db.beginTransaction();
+
+        if (!op(i))
+            result.failures++;
+
+        if (batch > 1 && (i % batch == batch - 1 || i == count - 1))
+            db.commitTransaction();
+
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        result.latencyUs.push_back(us);
+        result.totalUs += us;
+        result.histogram[bucketOf(us)]++;
+    }
+
+    sort(result.latencyUs.begin(), result.latencyUs.end());
+    results.push_back(result);
+}
+
+static bool runConfig(const RunConfig &config, vector<MethodResult> &results)
+{
+    remove(config.path.c_str());
+    remove((config.path + "-wal").c_str());
+    remove((config.path + "-shm").c_str());
+    remove((config.path + "-journal").c_str());
+
+    Database db;
+    db.setVerbose(false);
+    if (!db.open(config.path))
+        return false;
+
+    if (!db.execute("PRAGMA journal_mode = " + config.journal + ";") ||
+        !db.execute("PRAGMA synchronous = " + config.sync + ";"))
+    {
+        db.close();
+        return false;
+    }
+
+    const int n = config.ops;
+    const int b = config.batch;
+    const int firstKomikId = db.getLastKomikId() + 1;
+    const int firstUserId = db.getLastUserId() + 1;
+    const int readOps = n;
+    const int scanOps = max(1, n / 50); // query yang membaca seluruh tabel
+
+    // ===== INSERT =====
+    measure(db, config, "insertGenre", n, b, [&](int i)
+            { return db.insertGenre(numbered("Genre", i)); }, results);
+    measure(db, config, "insertAuthor", n, b, [&](int i)
+            { return db.insertAuthor(numbered("Author", i)); }, results);
+    measure(db, config, "insertKomik", n, b, [&](int i)
+            {
+        Komik komik(firstKomikId + i, numbered("Komik Benchmark", i), numbered("Author", i), "Action, Drama");
+        return db.insertKomik(&komik); }, results);
+    measure(db, config, "insertUser", n, b, [&](int i)
+            { return db.insertUser(User(firstUserId + i, numbered("bench", i), "HASH_x", "user")); }, results);
+    measure(db, config, "addFavorite", n, b, [&](int i)
+            { return db.addFavorite(numbered("bench", i % 50), firstKomikId + i); }, results);
+
+    // ===== READ (tanpa transaction) =====
+    measure(db, config, "getKomikById", readOps, 1, [&](int i)
+            {
+        Komik *komik = db.getKomikById(firstKomikId + (i * 7919) % n);
+        bool ok = komik != nullptr;
+        delete komik;
+        return ok; }, results);
+    measure(db, config, "getKomiksPage", readOps, 1, [&](int i)
+            {
+        vector<Komik *> page = db.getKomiksPage(numbered("Komik Benchmark", (i * 7919) % n), 0, 20);
+        for (Komik *komik : page)
+            delete komik;
+        return true; }, results);
+    measure(db, config, "genreExists", readOps, 1, [&](int i)
+            { return db.genreExists(numbered("Genre", (i * 7919) % n)); }, results);
+    measure(db, config, "authorExists", readOps, 1, [&](int i)
+            { return db.authorExists(numbered("Author", (i * 7919) % n)); }, results);
+    measure(db, config, "userExists", readOps, 1, [&](int i)
+            { return db.userExists(numbered("bench", (i * 7919) % n)); }, results);
+    measure(db, config, "getUserByUsername", readOps, 1, [&](int i)
+            {
+        User *user = db.getUserByUsername(numbered("bench", (i * 7919) % n));
+        bool ok = user != nullptr;
+        delete user;
+        return ok; }, results);
+    measure(db, config, "isFavorite", readOps, 1, [&](int i)
+            { return db.isFavorite(numbered("bench", i % 50), firstKomikId + i); }, results);
+    measure(db, config, "getFavoritesByUser", readOps, 1, [&](int i)
+            { return !db.getFavoritesByUser(numbered("bench", i % 50)).empty(); }, results);
+    measure(db, config, "getLastKomikId", readOps, 1, [&](int)
+            { return db.getLastKomikId() > 0; }, results);
+    measure(db, config, "countKomiks", scanOps, 1, [&](int)
+            { return db.countKomiks() >= n; }, results);
+    measure(db, config, "getAllKomiks", scanOps, 1, [&](int)
+            {
+        vector<Komik *> komiks = db.getAllKomiks();
+        for (Komik *komik : komiks)
+            delete komik;
+        return !komiks.empty(); }, results);
+    measure(db, config, "getAllGenres", scanOps, 1, [&](int)
+            { return !db.getAllGenres().empty(); }, results);
+    measure(db, config, "getAllAuthors", scanOps, 1, [&](int)
+            { return !db.getAllAuthors().empty(); }, results);
+    measure(db, config, "getAllUsers", scanOps, 1, [&](int)
+            { return !db.getAllUsers().empty(); }, results);
+    measure(db, config, "getFavoriteCounts", scanOps, 1, [&](int)
+            { return !db.getFavoriteCounts().empty(); }, results);
+    measure(db, config, "getAllFavorites", scanOps, 1, [&](int)
+            { return !db.getAllFavorites().empty(); }, results);
+    measure(db, config, "getKomiksFingerprint", scanOps, 1, [&](int)
+            { db.getKomiksFingerprint(); return true; }, results);
+
+    // ===== UPDATE =====
+    measure(db, config, "updateGenre", n, b, [&](int i)
+            { return db.updateGenre(numbered("Genre", i), numbered("Genre Baru", i)); }, results);
+    measure(db, config, "updateAuthor", n, b, [&](int i)
+            { return db.updateAuthor(numbered("Author", i), numbered("Author Baru", i)); }, results);
+    measure(db, config, "updateKomik", n, b, [&](int i)
+            {
+        Komik komik(firstKomikId + i, numbered("Komik Benchmark Baru", i), numbered("Author Baru", i), "Comedy");
+        return db.updateKomik(firstKomikId + i, &komik); }, results);
+    measure(db, config, "updateUser", n, b, [&](int i)
+            { return db.updateUser(User(firstUserId + i, numbered("bench", i), "HASH_y", "user")); }, results);
+
+    // ===== DELETE =====
+    measure(db, config, "removeFavorite", n, b, [&](int i)
+            { return db.removeFavorite(numbered("bench", i % 50), firstKomikId + i); }, results);
+    measure(db, config, "deleteKomik", n, b, [&](int i)
+            { return db.deleteKomik(firstKomikId + i); }, results);
+    measure(db, config, "deleteGenre", n, b, [&](int i)
+            { return db.deleteGenre(numbered("Genre Baru", i)); }, results);
+    measure(db, config, "deleteAuthor", n, b, [&](int i)
+            { return db.deleteAuthor(numbered("Author Baru", i)); }, results);
+    measure(db, config, "deleteUser", n, b, [&](int i)
+            { return db.deleteUser(numbered("bench", i)); }, results);
+
+    // ===== BULK =====
+    // insertKomiksBulk satu call per batch (di dalam transaction), latency per row
+    vector<Komik *> bulk;
+    for (int i = 0; i < n; i++)
+        bulk.push_back(new Komik(firstKomikId + n + i, numbered("Komik Bulk", i), "Author Bulk", "Fantasy"));
+
+    int chunk = max(1, b);
+    MethodResult bulkResult;
+    bulkResult.journal = config.journal;
+    bulkResult.sync = config.sync;
+    bulkResult.batch = config.batch;
+    bulkResult.method = "insertKomiksBulk/row";
+    for (int start = 0; start < n; start += chunk)
+    {
+        vector<Komik *> part(bulk.begin() + start, bulk.begin() + min(n, start + chunk));
+        auto begin = chrono::steady_clock::now();
+        db.beginTransaction();
+        if (db.insertKomiksBulk(part) != (int)part.size())
+            bulkResult.failures++;
+        db.commitTransaction();
+        double perRow = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count() / part.size();
+
+        for (size_t r = 0; r < part.size(); r++)
+        {
+            bulkResult.latencyUs.push_back(perRow);
+            bulkResult.totalUs += perRow;
+            bulkResult.histogram[bucketOf(perRow)]++;
+        }
+    }
+    sort(bulkResult.latencyUs.begin(), bulkResult.latencyUs.end());
+    results.push_back(bulkResult);
+
+    for (Komik *komik : bulk)
+        delete komik;
+
+    db.close();
+    return true;
+}
+
+static vector<string> splitList(const string &list)
+{
+    vector<string> items;
+    stringstream ss(list);
+    string item;
+    while (getline(ss, item, ','))
+    {
+        if (!item.empty())
+            items.push_back(item);
+    }
+    return items;
+}
+
+static void printHistogram(const MethodResult &r)
+{
+    printf("    ");
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++)
+    {
+        if (r.histogram[b] == 0)
+            continue;
+        if (b == HISTOGRAM_BUCKETS - 1)
+            printf(" >=%lluus:%llu", 1ULL << (b - 1), r.histogram[b]);
+        else
+            printf(" <%lluus:%llu", 1ULL << b, r.histogram[b]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int ops = 500;
+    vector<string> journals = splitList("delete,wal");
+    vector<string> syncs = splitList("full,normal");
+    vector<string> batches = splitList("1,100");
+    string path = "bench_db.db";
+    string jsonPath;
+    bool showHistogram = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--ops" && i + 1 < argc)
+            ops = max(1, atoi(argv[++i]));
+        else if (arg == "--journal" && i + 1 < argc)
+            journals = splitList(argv[++i]);
+        else if (arg == "--sync" && i + 1 < argc)
+            syncs = splitList(argv[++i]);
+        else if (arg == "--batch" && i + 1 < argc)
+            batches = splitList(argv[++i]);
+        else if (arg == "--db" && i + 1 < argc)
+            path = argv[++i];
+        else if (arg == "--histogram")
+            showHistogram = true;
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+    }
+
+    vector<MethodResult> results;
+    for (const string &journal : journals)
+    {
+        for (const string &sync : syncs)
+        {
+            for (const string &batch : batches)
+            {
+                RunConfig config;
+                config.journal = journal;
+                config.sync = sync;
+                config.batch = max(1, atoi(batch.c_str()));
+                config.ops = ops;
+                config.path = path;
+
+                size_t first = results.size();
+                if (!runConfig(config, results))
+                {
+                    fprintf(stderr, "Run failed: journal=%s sync=%s batch=%d\n", journal.c_str(), sync.c_str(), config.batch);
+                    return 1;
+                }
+
+                printf("\n== journal=%s synchronous=%s batch=%d ==\n", journal.c_str(), sync.c_str(), config.batch);
+                printf("%-22s %8s %12s %10s %10s %10s %6s\n", "method", "ops", "ops/s", "p50 us", "p99 us", "max us", "fail");
+                for (size_t r = first; r < results.size(); r++)
+                {
+                    const MethodResult &m = results[r];
+                    printf("%-22s %8zu %12.1f %10.1f %10.1f %10.1f %6d\n", m.method.c_str(), m.latencyUs.size(),
+                           m.latencyUs.size() / (m.totalUs / 1e6), percentile(m.latencyUs, 0.50),
+                           percentile(m.latencyUs, 0.99), m.latencyUs.empty() ? 0 : m.latencyUs.back(), m.failures);
+                    if (showHistogram)
+                        printHistogram(m);
+                }
+            }
+        }
+    }
+
+    remove(path.c_str());
+    remove((path + "-wal").c_str());
+    remove((path + "-shm").c_str());
+
+    if (!jsonPath.empty())
+    {
+        FILE *out = fopen(jsonPath.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+            return 1;
+        }
+
+        fprintf(out, "{\n  \"benchmark\": \"database\",\n  \"ops\": %d,\n  \"results\": [\n", ops);
+        for (size_t r = 0; r < results.size(); r++)
+        {
+            const MethodResult &m = results[r];
+            fprintf(out, "    {\"journal\": \"%s\", \"synchronous\": \"%s\", \"batch\": %d, \"method\": \"%s\", "
+                         "\"ops\": %zu, \"ops_per_sec\": %.1f, \"p50_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f, "
+                         "\"failures\": %d, \"histogram_pow2_us\": [",
+                    m.journal.c_str(), m.sync.c_str(), m.batch, m.method.c_str(), m.latencyUs.size(),
+                    m.latencyUs.size() / (m.totalUs / 1e6), percentile(m.latencyUs, 0.50), percentile(m.latencyUs, 0.99),
+                    m.latencyUs.empty() ? 0 : m.latencyUs.back(), m.failures);
+            for (int b = 0; b < HISTOGRAM_BUCKETS; b++)
+                fprintf(out, "%s%llu", b ? ", " : "", m.histogram[b]);
+            fprintf(out, "]}%s\n", r + 1 < results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+        fclose(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,371 @@
+/*
+ * bench_search.cpp
+ * Benchmark end-to-end SearchFilter dengan campuran query (query mix) di atas
+ * katalog sintetis dari CatalogGenerator. Laporan per tipe query: jumlah,
+ * throughput (query/detik), latency p50/p95/p99/max, rata-rata jumlah hasil,
+ * dan rata-rata alokasi heap per query (AllocTracker).
+ *
+ * Tipe query:
+ *   title          searchByTitle (substring title)
+ *   author_partial searchByAuthor (potongan nama author)
+ *   author_exact   filterByAuthor (nama author lengkap)
+ *   genre_and      searchByGenre dengan 2 genre (harus punya SEMUA)
+ *   multi          filterByMultiple (genre + potongan author)
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 -I include bench/bench_search.cpp -o bench_search -lsqlite3 -lpthread
+ * Jalankan:
+ *   ./bench_search [--comics 100000] [--queries 300] [--seed 42] [--threads N]
+ *                  [--mix file.txt] [--json hasil.json]
+ *
+ * File --mix (query mix rekaman): satu query per baris, field dipisah '|':
+ *   title|dragon
+ *   author_partial|tanaka
+ *   author_exact|Akira Tanaka
+ *   genre_and|Action, Drama
+ *   multi|Fantasy|sato
+ * Baris kosong dan baris diawali '#' diabaikan.
+ */
+
+// Hook operator new/delete untuk kolom allocs/query
+#define KOMIK_TRACK_ALLOC
+
+#include "../include/BST.h"
+#include "../include/SearchFilter.h"
+#include "../include/CatalogGenerator.h"
+#include "../src/BST.cpp"
+#include "../src/TableRenderer.cpp"
+#include "../src/MemoryReport.cpp"
+#include "../src/SearchFilter.cpp"
+#include "../src/MappedFile.cpp"
+#include "../src/Snapshot.cpp"
+#include "../src/CatalogImage.cpp"
+#include "../src/SlowQueryLog.cpp"
+#include "../src/WriteBehindQueue.cpp"
+#include "../src/Database.cpp"
+#include "../src/Auth.cpp"
+#include "../src/Exporter.cpp"
+#include "../src/CatalogGenerator.cpp"
+#include "../src/Metrics.cpp"
+#include "../src/AllocTracker.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum QueryType
+{
+    QUERY_TITLE,
+    QUERY_AUTHOR_PARTIAL,
+    QUERY_AUTHOR_EXACT,
+    QUERY_GENRE_AND,
+    QUERY_MULTI,
+    QUERY_TYPE_COUNT
+};
+
+static const char *QUERY_NAMES[QUERY_TYPE_COUNT] = {"title", "author_partial", "author_exact", "genre_and", "multi"};
+
+// Bobot query mix sintetis (persen), kira-kira pola pemakaian menu search
+static const int QUERY_WEIGHTS[QUERY_TYPE_COUNT] = {40, 15, 15, 15, 15};
+
+struct Query
+{
+    QueryType type;
+    string arg1;
+    string arg2;
+};
+
+struct TypeStats
+{
+    vector<double> latencyUs;
+    double totalUs;
+    unsigned long long hits;
+    unsigned long long allocations;
+    unsigned long long allocatedBytes;
+
+    TypeStats() : totalUs(0), hits(0), allocations(0), allocatedBytes(0) {}
+};
+
+static bool parseQueryType(const string &name, QueryType &type)
+{
+    for (int t = 0; t < QUERY_TYPE_COUNT; t++)
+    {
+        if (name == QUERY_NAMES[t])
+        {
+            type = (QueryType)t;
+            return true;
+        }
+    }
+    return false;
+}
+
+static vector<string> splitPipe(const string &line)
+{
+    vector<string> fields;
+    size_t start = 0;
+    while (true)
+    {
+        size_t pos = line.find('|', start);
+        fields.push_back(line.substr(start, pos == string::npos ? string::npos : pos - start));
+        if (pos == string::npos)
+            break;
+        start = pos + 1;
+    }
+    return fields;
+}
+
+static bool loadMix(const string &path, vector<Query> &queries)
+{
+    ifstream file(path.c_str());
+    if (!file)
+    {
+        fprintf(stderr, "Cannot open %s\n", path.c_str());
+        return false;
+    }
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        vector<string> fields = splitPipe(line);
+        Query query;
+        if (fields.size() < 2 || !parseQueryType(fields[0], query.type))
+        {
+            fprintf(stderr, "Line %d: unknown query '%s'\n", lineNumber, line.c_str());
+            return false;
+        }
+        query.arg1 = fields[1];
+        query.arg2 = fields.size() > 2 ? fields[2] : "";
+        queries.push_back(query);
+    }
+    return true;
+}
+
+static string randomWord(const string &text, mt19937 &rng)
+{
+    vector<string> words;
+    size_t start = 0;
+    while (start < text.size())
+    {
+        size_t end = text.find_first_of(" ,.:()", start);
+        if (end == string::npos)
+            end = text.size();
+        if (end - start >= 3)
+            words.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return words.empty() ? text : words[rng() % words.size()];
+}
+
+// Query sintetis diambil dari isi katalog sendiri (komik acak), jadi
+// selektivitasnya realistis; ~10% query sengaja tidak ada hasilnya.
+static vector<Query> makeSyntheticMix(const vector<Komik *> &komiks, size_t count, unsigned int seed)
+{
+    mt19937 rng(seed + 1);
+    vector<Query> queries;
+    if (komiks.empty())
+        return queries;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int roll = (int)(rng() % 100), acc = 0, t = 0;
+        for (; t < QUERY_TYPE_COUNT - 1; t++)
+        {
+            acc += QUERY_WEIGHTS[t];
+            if (roll < acc)
+                break;
+        }
+
+        const Komik *source = komiks[rng() % komiks.size()];
+        bool miss = rng() % 10 == 0;
+        string lastName = source->author.substr(source->author.rfind(' ') + 1);
+
+        Query query;
+        query.type = (QueryType)t;
+        switch (query.type)
+        {
+        case QUERY_TITLE:
+            query.arg1 = miss ? "zzqx" : randomWord(source->title, rng);
+            break;
+        case QUERY_AUTHOR_PARTIAL:
+            query.arg1 = miss ? "zzqx" : lastName.substr(0, 4);
+            break;
+        case QUERY_AUTHOR_EXACT:
+            query.arg1 = miss ? "Nobody Zzqx" : source->author;
+            break;
+        case QUERY_GENRE_AND:
+        {
+            const Komik *other = komiks[rng() % komiks.size()];
+            query.arg1 = randomWord(source->genre, rng) + ", " + randomWord(other->genre, rng);
+            break;
+        }
+        default:
+            query.arg1 = randomWord(source->genre, rng);
+            query.arg2 = miss ? "zzqx" : lastName;
+            break;
+        }
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+static size_t runQuery(SearchFilter &filter, BST &tree, const Query &query)
+{
+    switch (query.type)
+    {
+    case QUERY_TITLE:
+        return filter.searchByTitle(tree, query.arg1).size();
+    case QUERY_AUTHOR_PARTIAL:
+        return filter.searchByAuthor(tree, query.arg1).size();
+    case QUERY_AUTHOR_EXACT:
+        return filter.filterByAuthor(tree, query.arg1).size();
+    case QUERY_GENRE_AND:
+        return filter.searchByGenre(tree, query.arg1).size();
+    default:
+        return filter.filterByMultiple(tree, query.arg1, query.arg2).size();
+    }
+}
+
+static double percentile(const vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char *argv[])
+{
+    GeneratorConfig config;
+    config.comics = 100000;
+    size_t queryCount = 300;
+    int threads = 1;
+    string mixPath;
+    string jsonPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--comics" && i + 1 < argc)
+            config.comics = atol(argv[++i]);
+        else if (arg == "--queries" && i + 1 < argc)
+            queryCount = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && i + 1 < argc)
+            config.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (arg == "--mix" && i + 1 < argc)
+            mixPath = argv[++i];
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+    }
+
+    // Katalog dibangun sekali; node dimiliki tree
+    CatalogGenerator generator(config);
+    vector<Komik *> komiks = generator.generateKomiks();
+    BST tree;
+    for (Komik *komik : komiks)
+        tree.insert(komik);
+
+    vector<Query> queries;
+    if (!mixPath.empty())
+    {
+        if (!loadMix(mixPath, queries))
+            return 1;
+    }
+    else
+    {
+        queries = makeSyntheticMix(komiks, queryCount, config.seed);
+    }
+
+    // threads = 1 berarti serial (baseline); > 1 paralel tanpa threshold
+    SearchFilter filter;
+    filter.setParallelism(threads, threads > 1 ? 0 : 20000);
+
+    // Warm-up: cache + page fault pertama tidak ikut diukur
+    for (size_t i = 0; i < queries.size() && i < 20; i++)
+        runQuery(filter, tree, queries[i]);
+
+    TypeStats stats[QUERY_TYPE_COUNT];
+    auto runStart = chrono::steady_clock::now();
+    for (const Query &query : queries)
+    {
+        AllocScope scope;
+        auto start = chrono::steady_clock::now();
+        size_t hits = runQuery(filter, tree, query);
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        AllocStats allocs = scope.delta();
+
+        TypeStats &s = stats[query.type];
+        s.latencyUs.push_back(us);
+        s.totalUs += us;
+        s.hits += hits;
+        s.allocations += allocs.allocations;
+        s.allocatedBytes += allocs.bytes;
+    }
+    double runSeconds = chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+
+    printf("catalog: %ld comics, %zu queries, threads %d, %.2f s, %.1f queries/s\n\n",
+           config.comics, queries.size(), threads, runSeconds, runSeconds > 0 ? queries.size() / runSeconds : 0.0);
+    printf("%-16s %8s %10s %10s %10s %10s %10s %10s %10s %12s\n", "query", "count", "qps", "p50 us", "p95 us", "p99 us",
+           "max us", "avg hits", "allocs/q", "bytes/q");
+
+    for (int t = 0; t < QUERY_TYPE_COUNT; t++)
+    {
+        TypeStats &s = stats[t];
+        if (s.latencyUs.empty())
+            continue;
+        sort(s.latencyUs.begin(), s.latencyUs.end());
+        printf("%-16s %8zu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %12.0f\n", QUERY_NAMES[t], s.latencyUs.size(),
+               s.latencyUs.size() / (s.totalUs / 1e6), percentile(s.latencyUs, 0.50), percentile(s.latencyUs, 0.95),
+               percentile(s.latencyUs, 0.99), s.latencyUs.back(), (double)s.hits / s.latencyUs.size(),
+               (double)s.allocations / s.latencyUs.size(), (double)s.allocatedBytes / s.latencyUs.size());
+    }
+
+    if (!jsonPath.empty())
+    {
+        FILE *out = fopen(jsonPath.c_str(), "w");
+        if (!out)
+        {
+            fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+            return 1;
+        }
+
+        fprintf(out, "{\n  \"benchmark\": \"search\",\n  \"comics\": %ld,\n  \"seed\": %u,\n  \"threads\": %d,\n"
+                     "  \"queries\": %zu,\n  \"queries_per_sec\": %.1f,\n  \"results\": [\n",
+                config.comics, config.seed, threads, queries.size(), runSeconds > 0 ? queries.size() / runSeconds : 0.0);
+
+        bool first = true;
+        for (int t = 0; t < QUERY_TYPE_COUNT; t++)
+        {
+            const TypeStats &s = stats[t];
+            if (s.latencyUs.empty())
+                continue;
+            fprintf(out, "%s    {\"query\": \"%s\", \"count\": %zu, \"qps\": %.1f, \"p50_us\": %.1f, \"p95_us\": %.1f, "
+                         "\"p99_us\": %.1f, \"max_us\": %.1f, \"avg_hits\": %.1f, \"allocs_per_query\": %.1f, "
+                         "\"bytes_per_query\": %.0f}",
+                    first ? "" : ",\n", QUERY_NAMES[t], s.latencyUs.size(), s.latencyUs.size() / (s.totalUs / 1e6),
+                    percentile(s.latencyUs, 0.50), percentile(s.latencyUs, 0.95), percentile(s.latencyUs, 0.99),
+                    s.latencyUs.back(), (double)s.hits / s.latencyUs.size(), (double)s.allocations / s.latencyUs.size(),
+                    (double)s.allocatedBytes / s.latencyUs.size());
+            first = false;
+        }
+        fprintf(out, "\n  ]\n}\n");
+        fclose(out);
+    }
+
+    return 0;
+}
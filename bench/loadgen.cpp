@@ -0,0 +1,191 @@
+/*
+ * loadgen.cpp
+ * Load generator untuk server mode (main.exe --server <socket>).
+ * Setiap koneksi mengirim request campuran (search / get / count) satu per
+ * satu dan mengukur latency per request. POSIX saja (Unix domain socket).
+ *
+ * Build:
+ *   g++ -std=c++11 -O2 bench/loadgen.cpp -o loadgen -lpthread
+ * Jalankan (jumlah koneksi boleh lebih dari --threads server):
+ *   ./loadgen <socket> [connections] [seconds]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+class Connection
+{
+private:
+    int fd;
+    string buffer;
+
+public:
+    Connection() : fd(-1) {}
+    ~Connection()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    bool open(const string &path)
+    {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        return fd >= 0 && connect(fd, (sockaddr *)&address, sizeof(address)) == 0;
+    }
+
+    // Kirim satu command, baca sampai baris OK / ERR. Baris RESULT dikumpulkan.
+    bool request(const string &command, vector<string> &results, bool &ok)
+    {
+        string line = command + "\n";
+        if (send(fd, line.data(), line.size(), 0) != (ssize_t)line.size())
+            return false;
+
+        results.clear();
+        char chunk[65536];
+        while (true)
+        {
+            size_t newline;
+            while ((newline = buffer.find('\n')) != string::npos)
+            {
+                string reply = buffer.substr(0, newline);
+                buffer.erase(0, newline + 1);
+                if (reply.compare(0, 2, "OK") == 0 || reply.compare(0, 3, "ERR") == 0)
+                {
+                    ok = reply[0] == 'O';
+                    return true;
+                }
+                results.push_back(reply);
+            }
+
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0)
+                return false;
+            buffer.append(chunk, n);
+        }
+    }
+};
+
+static double percentile(const vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = (size_t)(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <socket> [connections] [seconds]\n", argv[0]);
+        return 1;
+    }
+
+    string path = argv[1];
+    int connections = argc > 2 ? atoi(argv[2]) : 4;
+    int seconds = argc > 3 ? atoi(argv[3]) : 5;
+
+    // Ambil contoh title dari server untuk request get / search
+    vector<string> titles;
+    {
+        Connection probe;
+        vector<string> results;
+        bool ok = false;
+        if (!probe.open(path) || !probe.request("list|500", results, ok) || !ok)
+        {
+            fprintf(stderr, "cannot reach server at %s\n", path.c_str());
+            return 1;
+        }
+        for (const string &row : results)
+        {
+            // RESULT\tid\ttitle\tauthor\tgenre
+            size_t a = row.find('\t', 7);
+            size_t b = row.find('\t', a + 1);
+            titles.push_back(row.substr(a + 1, b - a - 1));
+        }
+    }
+    if (titles.empty())
+        titles.push_back("a");
+
+    atomic<bool> stop(false);
+    atomic<long> errors(0);
+    vector<vector<double>> latencies(connections);
+    vector<thread> threads;
+
+    for (int c = 0; c < connections; c++)
+    {
+        threads.push_back(thread([&, c]()
+                                 {
+            Connection conn;
+            if (!conn.open(path))
+            {
+                errors++;
+                return;
+            }
+
+            mt19937 rng(c);
+            vector<string> results;
+            vector<double> &samples = latencies[c];
+
+            while (!stop.load())
+            {
+                const string &title = titles[rng() % titles.size()];
+                string command;
+                int kind = rng() % 10;
+                if (kind < 6)
+                    command = "search|" + title.substr(0, min<size_t>(3, title.size()));
+                else if (kind < 9)
+                    command = "get|" + title;
+                else
+                    command = "count";
+
+                bool ok = false;
+                auto start = chrono::steady_clock::now();
+                if (!conn.request(command, results, ok))
+                {
+                    errors++;
+                    return;
+                }
+                samples.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+                if (!ok)
+                    errors++;
+            } }));
+    }
+
+    auto begin = chrono::steady_clock::now();
+    this_thread::sleep_for(chrono::seconds(seconds));
+    stop = true;
+    for (thread &t : threads)
+        t.join();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    vector<double> all;
+    for (const vector<double> &samples : latencies)
+        all.insert(all.end(), samples.begin(), samples.end());
+    sort(all.begin(), all.end());
+
+    printf("connections=%d seconds=%.2f requests=%zu errors=%ld\n", connections, elapsed, all.size(), errors.load());
+    printf("requests_per_sec=%.0f\n", all.size() / elapsed);
+    printf("latency_us p50=%.1f p99=%.1f max=%.1f\n",
+           percentile(all, 0.50), percentile(all, 0.99), all.empty() ? 0.0 : all.back());
+    return errors.load() == 0 ? 0 : 1;
+}
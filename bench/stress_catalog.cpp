@@ -0,0 +1,157 @@
+/*
+ * stress_catalog.cpp
+ * Stress ConcurrentCatalog: reader paralel (searchPartial / search / page)
+ * bersamaan dengan writer insert / update / remove.
+ *
+ * Build (ThreadSanitizer, Linux/MSYS2 clang atau gcc):
+ *   g++ -std=c++11 -O1 -g -fsanitize=thread -I include bench/stress_catalog.cpp -o stress_catalog -lpthread
+ * Jalankan:
+ *   ./stress_catalog [readers] [writers] [seconds]
+ */
+
+#include "../include/BST.h"
+#include "../include/ConcurrentCatalog.h"
+#include "../src/BST.cpp"
+#include "../src/TableRenderer.cpp"
+#include "../src/MemoryReport.cpp"
+#include "../src/RWLock.cpp"
+#include "../src/ConcurrentCatalog.cpp"
+#include "../src/Metrics.cpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+const int KEYS_PER_WRITER = 2000;
+
+static string keyTitle(int writer, int key)
+{
+    return "W" + to_string(writer) + "-" + to_string(key);
+}
+
+int main(int argc, char *argv[])
+{
+    int readers = argc > 1 ? atoi(argv[1]) : 4;
+    int writers = argc > 2 ? atoi(argv[2]) : 2;
+    int seconds = argc > 3 ? atoi(argv[3]) : 3;
+
+    BST tree;
+    ConcurrentCatalog catalog(tree);
+
+    atomic<bool> stop(false);
+    atomic<long> readOps(0), writeOps(0), badReads(0);
+    vector<set<string>> present(writers); // hanya disentuh oleh writer pemiliknya
+    vector<thread> threads;
+
+    for (int w = 0; w < writers; w++)
+    {
+        threads.push_back(thread([&, w]()
+                                 {
+            mt19937 rng(1000 + w);
+            uniform_int_distribution<int> pickKey(0, KEYS_PER_WRITER - 1);
+            long ops = 0;
+
+            while (!stop.load())
+            {
+                string title = keyTitle(w, pickKey(rng));
+                if (present[w].count(title))
+                {
+                    if (rng() % 2)
+                    {
+                        catalog.remove(title);
+                        present[w].erase(title);
+                    }
+                    else
+                    {
+                        catalog.update(title, Komik(w, title, "Author", "Genre" + to_string(rng() % 8)));
+                    }
+                }
+                else
+                {
+                    catalog.insert(Komik(w, title, "Author", "Action"));
+                    present[w].insert(title);
+                }
+                ops++;
+            }
+            writeOps += ops; }));
+    }
+
+    for (int r = 0; r < readers; r++)
+    {
+        threads.push_back(thread([&, r]()
+                                 {
+            mt19937 rng(r);
+            long ops = 0, bad = 0;
+
+            while (!stop.load())
+            {
+                int writer = writers > 0 ? (int)(rng() % writers) : 0;
+                switch (rng() % 3)
+                {
+                case 0:
+                {
+                    string keyword = "w" + to_string(writer) + "-1";
+                    for (const Komik &k : catalog.searchPartial(keyword))
+                    {
+                        if (k.left != nullptr || k.right != nullptr || k.title.empty())
+                            bad++;
+                    }
+                    break;
+                }
+                case 1:
+                {
+                    Komik found;
+                    string title = keyTitle(writer, rng() % KEYS_PER_WRITER);
+                    if (catalog.search(title, found) && found.title != title)
+                        bad++;
+                    break;
+                }
+                default:
+                {
+                    vector<Komik> page = catalog.page(nullptr, 20);
+                    for (size_t i = 1; i < page.size(); i++)
+                    {
+                        if (!(page[i - 1] < page[i]))
+                            bad++;
+                    }
+                    break;
+                }
+                }
+                ops++;
+            }
+            readOps += ops;
+            badReads += bad; }));
+    }
+
+    this_thread::sleep_for(chrono::seconds(seconds));
+    stop = true;
+    for (thread &t : threads)
+        t.join();
+
+    // Validasi akhir: isi tree sama dengan yang dicatat writer dan tetap terurut
+    size_t expected = 0;
+    for (const set<string> &keys : present)
+        expected += keys.size();
+
+    vector<Komik> all = catalog.getAllKomiks();
+    bool sorted = true;
+    for (size_t i = 1; i < all.size(); i++)
+    {
+        if (!(all[i - 1] < all[i]))
+            sorted = false;
+    }
+
+    bool ok = all.size() == expected && sorted && badReads.load() == 0;
+
+    printf("readers=%d writers=%d seconds=%d\n", readers, writers, seconds);
+    printf("read_ops=%ld write_ops=%ld bad_reads=%ld\n", readOps.load(), writeOps.load(), badReads.load());
+    printf("final_count=%zu expected=%zu sorted=%s\n", all.size(), expected, sorted ? "yes" : "no");
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/*
+ * stress_persistent.cpp
+ * Stress PersistentBST: reader tanpa lock membaca snapshot sementara
+ * writer insert / update / remove. Setiap writer punya key "stabil" yang
+ * hanya di-update (remove + insert), jadi reader tidak boleh pernah
+ * kehilangan key tersebut.
+ *
+ * Build (ThreadSanitizer):
+ *   g++ -std=c++11 -O1 -g -fsanitize=thread -I include bench/stress_persistent.cpp -o stress_persistent -lpthread
+ * Jalankan:
+ *   ./stress_persistent [readers] [writers] [seconds]
+ */
+
+#include "../include/BST.h"
+#include "../include/PersistentBST.h"
+#include "../src/BST.cpp"
+#include "../src/TableRenderer.cpp"
+#include "../src/MemoryReport.cpp"
+#include "../src/PersistentBST.cpp"
+#include "../src/Metrics.cpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+const int KEYS_PER_WRITER = 2000;
+const int STABLE_KEYS = 50;
+
+static string keyTitle(int writer, int key)
+{
+    return "W" + to_string(writer) + "-" + to_string(key);
+}
+
+static string stableTitle(int writer, int key)
+{
+    return "S" + to_string(writer) + "-" + to_string(key);
+}
+
+int main(int argc, char *argv[])
+{
+    int readers = argc > 1 ? atoi(argv[1]) : 4;
+    int writers = argc > 2 ? atoi(argv[2]) : 2;
+    int seconds = argc > 3 ? atoi(argv[3]) : 3;
+
+    PersistentBST tree;
+    for (int w = 0; w < writers; w++)
+    {
+        for (int k = 0; k < STABLE_KEYS; k++)
+            tree.insert(Komik(k, stableTitle(w, k), "Author", "Genre0"));
+    }
+
+    atomic<bool> stop(false);
+    atomic<long> readOps(0), writeOps(0), violations(0);
+    vector<set<string>> present(writers);
+    vector<thread> threads;
+
+    for (int w = 0; w < writers; w++)
+    {
+        threads.push_back(thread([&, w]()
+                                 {
+            mt19937 rng(1000 + w);
+            uniform_int_distribution<int> pickKey(0, KEYS_PER_WRITER - 1);
+            long ops = 0;
+
+            while (!stop.load())
+            {
+                if (rng() % 4 == 0)
+                {
+                    // Update key stabil: ganti genre (posisi di tree ikut berubah)
+                    int k = rng() % STABLE_KEYS;
+                    tree.update(stableTitle(w, k), Komik(k, stableTitle(w, k), "Author", "Genre" + to_string(rng() % 8)));
+                }
+                else
+                {
+                    string title = keyTitle(w, pickKey(rng));
+                    if (present[w].count(title))
+                    {
+                        tree.remove(title);
+                        present[w].erase(title);
+                    }
+                    else
+                    {
+                        tree.insert(Komik(w, title, "Author", "Action"));
+                        present[w].insert(title);
+                    }
+                }
+                ops++;
+            }
+            writeOps += ops; }));
+    }
+
+    for (int r = 0; r < readers; r++)
+    {
+        threads.push_back(thread([&, r]()
+                                 {
+            mt19937 rng(r);
+            long ops = 0, bad = 0;
+
+            while (!stop.load())
+            {
+                PersistentBST::Version version = tree.snapshot();
+                int writer = writers > 0 ? (int)(rng() % writers) : 0;
+
+                switch (rng() % 3)
+                {
+                case 0:
+                {
+                    // Scan panjang di atas snapshot: writer tetap jalan
+                    size_t seen = 0;
+                    bool sorted = true;
+                    Komik previous;
+                    version.inOrder([&](const Komik &k)
+                                    {
+                        if (seen > 0 && !(previous < k))
+                            sorted = false;
+                        previous = Komik(k.id, k.title, k.author, k.genre);
+                        seen++; });
+                    if (!sorted || seen != version.count())
+                        bad++;
+                    break;
+                }
+                case 1:
+                {
+                    Komik found;
+                    for (int k = 0; k < STABLE_KEYS; k++)
+                    {
+                        if (!version.search(stableTitle(writer, k), found))
+                            bad++; // update setengah jalan terlihat
+                    }
+                    break;
+                }
+                default:
+                {
+                    vector<Komik> hits = version.searchPartial("s" + to_string(writer) + "-");
+                    if (hits.size() != (size_t)STABLE_KEYS)
+                        bad++;
+                    break;
+                }
+                }
+                ops++;
+            }
+            readOps += ops;
+            violations += bad; }));
+    }
+
+    this_thread::sleep_for(chrono::seconds(seconds));
+    stop = true;
+    for (thread &t : threads)
+        t.join();
+
+    size_t expected = (size_t)writers * STABLE_KEYS;
+    for (const set<string> &keys : present)
+        expected += keys.size();
+
+    PersistentBST::Version last = tree.snapshot();
+    bool ok = last.count() == expected && last.getAllKomiks().size() == expected && violations.load() == 0;
+
+    printf("readers=%d writers=%d seconds=%d\n", readers, writers, seconds);
+    printf("read_ops=%ld write_ops=%ld violations=%ld versions=%llu\n",
+           readOps.load(), writeOps.load(), violations.load(), last.getNumber());
+    printf("final_count=%zu expected=%zu\n", last.count(), expected);
+    printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
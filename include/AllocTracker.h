@@ -0,0 +1,56 @@
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <string>
+
+using namespace std;
+
+// Penghitung alokasi heap global (operator new / delete). Opt-in: hook hanya
+// dipasang kalau AllocTracker.cpp di-compile dengan -DKOMIK_TRACK_ALLOC
+// (dipakai bench untuk budget alokasi). Tanpa flag itu tracking() = false
+// dan semua angka tetap 0, program utama tidak terpengaruh.
+// Counter global atomic: alokasi dari thread lain ikut terhitung di scope.
+
+struct AllocStats
+{
+    unsigned long long allocations;
+    unsigned long long frees;
+    unsigned long long bytes; // total byte yang diminta lewat operator new
+
+    AllocStats() : allocations(0), frees(0), bytes(0) {}
+};
+
+class AllocTracker
+{
+public:
+    static bool tracking();
+
+    // Total sejak program mulai
+    static AllocStats current();
+
+    // Dipanggil dari hook operator new / delete
+    static void recordAlloc(size_t bytes);
+    static void recordFree();
+};
+
+// Alokasi dari konstruksi sampai sekarang
+class AllocScope
+{
+private:
+    AllocStats start;
+
+    AllocScope(const AllocScope &);
+    AllocScope &operator=(const AllocScope &);
+
+public:
+    AllocScope();
+
+    AllocStats delta() const;
+    unsigned long long allocations() const { return delta().allocations; }
+    unsigned long long bytes() const { return delta().bytes; }
+
+    // false + pesan ke cerr kalau jumlah alokasi melebihi budget
+    bool withinBudget(const string &name, unsigned long long maxAllocations) const;
+};
+
+#endif
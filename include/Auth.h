@@ -8,6 +8,8 @@
 
 using namespace std;
 
+class MemoryReport;
+
 struct User
 {
     int id;
@@ -36,7 +38,6 @@ private:
     User *currentUser;
     Database *db;
 
-    string hashPassword(const string &password);
     bool verifyPassword(const string &inputPassword, const string &storedPassword);
     bool usernameExists(const string &username);
     string getPasswordInput(const string &prompt);
@@ -45,10 +46,15 @@ public:
     Auth(Database *database);
     ~Auth();
 
+    // Format password yang disimpan di database (dipakai juga oleh CatalogGenerator)
+    static string hashPassword(const string &password);
+
     bool registerUser(const string &username, const string &password, const string &role = "user");
     bool registerWithMaskedPassword(const string &username, const string &role = "user");
     bool login(const string &username, const string &password);
     bool loginWithMaskedPassword(const string &username);
+    // Cek username + password tanpa mengubah currentUser dan tanpa output (untuk server)
+    bool authenticate(const string &username, const string &password, User &result);
     void logout();
     bool isLoggedIn() const;
 
@@ -65,6 +71,9 @@ public:
     void displayCurrentUser() const;
     void displayAllUsers() const;
     void loadUsersFromDB();
+
+    // Estimasi memory map users (node + string)
+    void accountMemory(MemoryReport &report) const;
 };
 
 #endif
\ No newline at end of file
@@ -7,33 +7,57 @@
 
 using namespace std;
 
+class MemoryReport;
+
+// Hasil diagnosa bentuk tree (depth root = 0, height = jumlah level)
+struct TreeShape
+{
+    int nodes;
+    int height;
+    int optimalHeight;         // tinggi tree seimbang sempurna: ceil(log2(n + 1))
+    double averageDepth;
+    int maxDepth;
+    vector<int> depthHistogram; // index = depth, isi = jumlah node di depth itu
+    int unbalancedNodes;        // node dengan |height(left) - height(right)| > 1
+    int maxImbalance;           // |balance factor| terbesar
+    string maxImbalanceTitle;   // node dengan imbalance terbesar
+
+    TreeShape() : nodes(0), height(0), optimalHeight(0), averageDepth(0), maxDepth(0),
+                  unbalancedNodes(0), maxImbalance(0) {}
+};
+
 class BST
 {
 private:
     Komik *root;
+    int nodeCount; // dijaga insert/delete/build, jadi count() O(1)
 
     Komik *insertHelper(Komik *node, Komik *newKomik);
     Komik *searchHelper(Komik *node, const string &title) const;
     Komik *deleteHelper(Komik *node, const string &title);
     Komik *findMin(Komik *node) const;
 
-    void preOrderHelper(Komik *node, function<void(Komik *)> callback) const;
-    void inOrderHelper(Komik *node, function<void(Komik *)> callback) const;
-    void postOrderHelper(Komik *node, function<void(Komik *)> callback) const;
+    void preOrderHelper(Komik *node, const function<void(Komik *)> &callback) const;
+    void inOrderHelper(Komik *node, const function<void(Komik *)> &callback) const;
+    void postOrderHelper(Komik *node, const function<void(Komik *)> &callback) const;
 
     void destroyTree(Komik *node);
-    int countHelper(Komik *node) const;
 
     // NEW: Helper untuk partial search
-    void searchPartialHelper(Komik *node, const string &keyword, vector<Komik *> &results) const;
+    // lowerKeyword sudah lowercase; title dibandingkan langsung tanpa copy (TextMatch.h)
+    void searchPartialHelper(Komik *node, const string &lowerKeyword, vector<Komik *> &results) const;
     string toLowerCase(const string &str) const;
 
+    Komik *buildBalancedHelper(const vector<Komik *> &komiks, int low, int high);
+    void collectNodes(Komik *node, vector<Komik *> &nodes) const;
+
 public:
     BST();
     ~BST();
 
     void insert(Komik *newKomik);
     Komik *search(const string &title) const;
+    Komik *find(const Komik &key) const; // exact match title + author + genre
 
     // NEW: Partial search (case-insensitive)
     Komik* findByKeyword(const string& keyword) const;
@@ -51,6 +75,22 @@ public:
     void clear();
     vector<Komik *> getAllKomiks() const;
 
+    // Cursor: ambil maksimal limit komik (in-order) yang lebih besar dari after.
+    // after = nullptr berarti mulai dari komik pertama. O(log n + limit)
+    vector<Komik *> collectAfter(const Komik *after, size_t limit) const;
+
+    // Bulk build dari komik yang sudah terurut (in-order), hasilnya tree seimbang
+    void buildBalanced(const vector<Komik *> &sortedKomiks);
+
+    // Bulk insert: gabung komik baru dengan isi tree lalu rebuild seimbang (O(n log n))
+    void bulkInsert(vector<Komik *> newKomiks);
+
+    // Diagnosa bentuk tree dalam satu pass iteratif (aman untuk tree miring)
+    TreeShape shape() const;
+
+    // Tambahkan estimasi memory node + string komik ke report
+    void accountMemory(MemoryReport &report) const;
+
     Komik *getRoot() const { return root; }
 };
 
@@ -0,0 +1,72 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <iostream>
+#include "BST.h"
+#include "KomikManager.h"
+#include "Database.h"
+
+using namespace std;
+
+// Mode batch (non-interaktif): satu command per baris, field dipisah '|' atau TAB
+//
+//   add|title|author|genre
+//   update|oldTitle|newTitle|author|genre   (field kosong = tidak diubah)
+//   delete|title
+//   fav|username|title
+//   unfav|username|title
+//   search|keyword
+//   commit                                   (paksa commit group sekarang)
+//
+// Baris kosong dan baris diawali '#' diabaikan.
+// Output: "RESULT\tid\ttitle\tauthor\tgenre", "ERR line N: ...", dan ringkasan "DONE ...".
+class BatchRunner
+{
+private:
+    BST &tree;
+    KomikManager &manager;
+    Database &db;
+
+    int groupSize;
+    int pendingWrites;
+    bool inTransaction;
+    long groupFirstLine; // baris write pertama di group yang belum di-commit
+    long currentLine;
+
+    set<string> knownAuthors;
+    set<string> knownGenres;
+    set<string> knownUsers;
+
+    bool validateGenres(const string &genreList, string &error) const;
+    bool ensureAuthor(const string &author);
+
+    void beginWrite();
+    // false kalau COMMIT gagal: group di-rollback (rolledBack = jumlah write di
+    // group itu), tree + cache KomikManager di-load ulang dari database
+    bool commitGroup(int *rolledBack = nullptr);
+    void reloadState();
+
+    bool cmdAdd(const vector<string> &fields, string &error);
+    bool cmdUpdate(const vector<string> &fields, string &error);
+    bool cmdDelete(const vector<string> &fields, string &error);
+    bool cmdFavorite(const vector<string> &fields, bool add, string &error);
+    bool cmdSearch(const vector<string> &fields, ostream &out, string &error);
+
+public:
+    BatchRunner(BST &tree, KomikManager &manager, Database &db);
+
+    // Pecah satu baris command jadi field (dipakai juga oleh CatalogServer)
+    static vector<string> splitFields(const string &line);
+    ~BatchRunner();
+
+    // Jumlah write per transaksi (default 500)
+    void setGroupSize(int size);
+
+    // Jalankan semua command dari stream, return jumlah command yang gagal
+    int run(istream &in, ostream &out);
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef CATALOGGENERATOR_H
+#define CATALOGGENERATOR_H
+
+#include <string>
+#include <vector>
+#include <random>
+#include <unordered_set>
+#include "Komik.h"
+#include "Database.h"
+
+using namespace std;
+
+struct GeneratorConfig
+{
+    long comics;
+    int users;
+    long favorites;
+    unsigned int seed;
+    double zipfExponent; // kemiringan popularitas komik untuk favorites
+
+    GeneratorConfig() : comics(10000), users(100), favorites(0), seed(42), zipfExponent(1.0) {}
+};
+
+struct GeneratorReport
+{
+    long comics;
+    int users;
+    long favorites;
+    int authors;
+    double ms;
+
+    GeneratorReport() : comics(0), users(0), favorites(0), authors(0), ms(0) {}
+};
+
+// Generator katalog sintetis yang deterministik (seed sama -> data sama):
+// - title 1-5 kata dari word list (panjang mirip katalog asli), selalu unik
+// - author: sebagian kecil author sangat produktif (distribusi Zipf)
+// - genre: 1-4 genre per komik, genre populer lebih sering muncul
+// - favorites: komik dipilih dengan distribusi Zipf (sedikit komik sangat populer)
+// Output langsung ke SQLite lewat Database (bulk insert) atau ke CSV
+// (format sama dengan --import: title,author,genre).
+class CatalogGenerator
+{
+private:
+    GeneratorConfig config;
+    mt19937 rng;
+    vector<string> authorNames;
+    vector<double> authorCdf;
+
+    // Random helper: hanya pakai output mt19937 (terdefinisi standar), bukan
+    // distribution std::, supaya hasil sama di semua compiler
+    unsigned int pick(unsigned int n);
+    double uniform();
+    static vector<double> zipfCdf(size_t n, double exponent);
+    size_t sampleCdf(const vector<double> &cdf);
+
+    void prepareAuthors();
+    string buildTitle();
+    string makeTitle(unordered_set<string> &usedTitles);
+    string makeGenres();
+
+public:
+    CatalogGenerator(const GeneratorConfig &config);
+
+    // Komik saja di memory (tanpa database), id mulai dari firstId; pemanggil
+    // yang delete. Urutan random sama dengan writeDatabase untuk seed yang sama.
+    vector<Komik *> generateKomiks(int firstId = 1);
+
+    bool writeDatabase(Database &db, GeneratorReport &report);
+    bool writeCsv(const string &path, GeneratorReport &report);
+};
+
+#endif
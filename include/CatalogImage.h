@@ -0,0 +1,52 @@
+#ifndef CATALOGIMAGE_H
+#define CATALOGIMAGE_H
+
+#include <string>
+#include <cstdint>
+#include "MappedFile.h"
+#include "Snapshot.h"
+
+using namespace std;
+
+// Satu baris katalog, string menunjuk langsung ke memory-mapped file (tidak null-terminated)
+struct CatalogEntry
+{
+    int id;
+    const char *title;
+    uint32_t titleLength;
+    const char *author;
+    uint32_t authorLength;
+    const char *genre;
+    uint32_t genreLength;
+};
+
+// Katalog read-only langsung dari file snapshot yang di-mmap,
+// tanpa membuat object Komik (untuk mode kiosk)
+class CatalogImage
+{
+private:
+    MappedFile file;
+    const SnapshotHeader *header;
+    const SnapshotRecord *records;
+    const char *pool;
+    size_t count;
+
+public:
+    CatalogImage();
+    ~CatalogImage();
+
+    bool open(const string &path);
+    void close();
+    bool isOpen() const;
+
+    // Cek checksum seluruh isi file (menyentuh semua page, opsional)
+    bool verify() const;
+
+    size_t size() const { return count; }
+    bool getEntry(size_t index, CatalogEntry &entry) const;
+
+    // Record urut by title, jadi exact match bisa binary search. Return -1 kalau tidak ada
+    long findByTitle(const string &title) const;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef CATALOGSERVER_H
+#define CATALOGSERVER_H
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "BST.h"
+#include "ConcurrentCatalog.h"
+#include "PersistentBST.h"
+#include "KomikManager.h"
+#include "Database.h"
+#include "Auth.h"
+
+using namespace std;
+
+// Server mode: satu proses memegang BST / KomikManager / Auth bersama dan
+// melayani banyak client lewat Unix domain socket (POSIX saja).
+//
+// Protocol: satu command per baris, field dipisah '|' atau TAB (sama seperti batch)
+//
+//   ping
+//   login|username|password
+//   search|keyword
+//   get|title
+//   list|limit                 (komik pertama urut title)
+//   count
+//   top|n
+//   favs                       (butuh login)
+//   fav|title / unfav|title    (butuh login)
+//   add|title|author|genre     (admin)
+//   delete|title               (admin)
+//   quit
+//
+// Setiap response berupa nol atau lebih baris "RESULT\t..." lalu diakhiri
+// tepat satu baris "OK ..." atau "ERR ...".
+class CatalogServer
+{
+private:
+    struct Session
+    {
+        string username;
+        string role;
+    };
+
+    // State per koneksi: selalu dipegang tepat satu pihak (event loop saat
+    // idle, satu worker saat ada data), jadi command per client tetap urut
+    struct Connection
+    {
+        int fd;
+        Session session;
+        string buffer;
+    };
+
+    // Read path (search/get/list/count/title lookup) membaca snapshot
+    // PersistentBST tanpa lock: search yang lama tidak menahan writer dan
+    // tidak pernah melihat add/delete setengah jalan. Writer (di bawah
+    // stateMutex) meng-update BST asli lewat catalog (untuk Snapshot::save
+    // saat shutdown) lalu mempublish versi baru.
+    ConcurrentCatalog catalog;
+    PersistentBST versions;
+    KomikManager &manager;
+    Database &db;
+    Auth &auth;
+
+    // KomikManager, Database (satu koneksi SQLite) dan Auth tidak thread-safe:
+    // semua akses ke sana lewat mutex ini. Search cukup ambil snapshot versions.
+    mutex stateMutex;
+
+    int threadCount;
+    atomic<bool> running;
+    int listenFd;
+
+    // Dispatch per request: event loop poll semua koneksi idle, koneksi yang
+    // punya data masuk ke readyClients dan diproses worker mana saja, lalu
+    // dikembalikan lewat returnedClients + wakePipe. Worker tidak pernah
+    // menunggu client yang diam, jadi jumlah koneksi tidak dibatasi --threads.
+    queue<Connection *> readyClients;
+    vector<Connection *> returnedClients;
+    mutex queueMutex;
+    condition_variable queueCv;
+    int wakePipe[2];
+
+    void workerLoop();
+    // Proses data yang sudah tersedia; false kalau koneksi harus ditutup
+    bool serveReady(Connection &connection);
+    bool handleCommand(const string &line, Session &session, string &response);
+
+    void appendKomik(string &response, const Komik &comic) const;
+    void appendTitled(string &response, const vector<pair<int, int>> &idValues);
+
+    CatalogServer(const CatalogServer &);
+    CatalogServer &operator=(const CatalogServer &);
+
+public:
+    CatalogServer(BST &tree, KomikManager &manager, Database &db, Auth &auth);
+    ~CatalogServer();
+
+    void setThreadCount(int count);
+
+    // Blocking sampai stop() dipanggil. Return 0 kalau berhenti normal.
+    int run(const string &socketPath);
+
+    // Aman dipanggil dari signal handler (hanya atomic store)
+    void stop();
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CONCURRENTCATALOG_H
+#define CONCURRENTCATALOG_H
+
+#include "BST.h"
+#include "RWLock.h"
+#include <string>
+#include <vector>
+#include <functional>
+
+using namespace std;
+
+// Facade thread-safe di atas BST: search paralel (shared lock), insert /
+// remove / update eksklusif. Semua hasil dikembalikan sebagai COPY Komik
+// (left/right = nullptr) supaya tidak ada pointer ke node yang bisa
+// dihapus writer lain setelah lock dilepas.
+class ConcurrentCatalog
+{
+private:
+    BST &tree;
+    mutable RWLock rw;
+
+    static Komik copyOf(const Komik *comic);
+
+public:
+    explicit ConcurrentCatalog(BST &tree);
+
+    // Readers (shared lock)
+    bool search(const string &title, Komik &result) const;
+    vector<Komik> searchPartial(const string &keyword) const;
+    vector<Komik> getAllKomiks() const;
+    vector<Komik> page(const Komik *after, size_t limit) const;
+    int count() const;
+
+    // Writers (exclusive lock)
+    void insert(const Komik &comic);
+    bool remove(const string &title);
+    bool update(const string &oldTitle, const Komik &updated);
+
+    // Akses langsung untuk operasi gabungan; pointer node tidak boleh
+    // disimpan setelah callback selesai
+    void withReadLock(const function<void(const BST &)> &callback) const;
+    void withWriteLock(const function<void(BST &)> &callback);
+};
+
+#endif
@@ -3,19 +3,47 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 #include <sqlite3.h>
 #include "Komik.h"
+#include "WriteBehindQueue.h"
 
 using namespace std;
 
 // Forward declaration
 struct User;
 
+// Ringkasan isi tabel komiks, dipakai untuk cek snapshot masih valid atau tidak
+struct TableFingerprint
+{
+    long long rowCount;
+    long long maxId;
+    long long payloadBytes;
+    unsigned int fileChangeCounter;
+
+    TableFingerprint() : rowCount(0), maxId(0), payloadBytes(0), fileChangeCounter(0) {}
+
+    bool operator==(const TableFingerprint &other) const
+    {
+        return rowCount == other.rowCount &&
+               maxId == other.maxId &&
+               payloadBytes == other.payloadBytes &&
+               fileChangeCounter == other.fileChangeCounter;
+    }
+};
+
 class Database
 {
 private:
     sqlite3 *db;
     string dbPath;
+    bool verbose;
+
+    // Write-behind (opsional): mutation komik / user / favorite di-commit
+    // oleh background thread, read selalu flush dulu
+    WriteBehindQueue writeQueue;
+    SlowQueryLog slowLog;
+    bool submitWrite(const WriteRecord &record);
 
     bool createTables();
 
@@ -27,14 +55,46 @@ public:
     bool open(const string &path);
     void close();
     bool isOpen() const;
+    const string &getPath() const { return dbPath; }
+    void setVerbose(bool enabled) { verbose = enabled; }
+
+    // Aktifkan write-behind: group commit setiap intervalMs. durableAck = true
+    // berarti write baru return setelah batch-nya ter-commit (tanpa window,
+    // batch dibentuk dari write yang antre selama commit sebelumnya).
+    bool enableWriteBehind(int intervalMs = 5, bool durableAck = false);
+    // false (dan pesan di cerr) kalau ada write antre yang dibuang sejak flush sebelumnya
+    bool flushWrites();
+    const WriteBehindQueue &getWriteQueue() const { return writeQueue; }
+
+    // Slow query log: statement (koneksi utama + writer) yang >= thresholdMs
+    // ditulis ke file beserta parameter dan row yang disentuh, file dirotasi
+    // setiap maxBytes. Boleh dipanggil sebelum atau sesudah open().
+    bool enableSlowQueryLog(const string &path, double thresholdMs, long maxBytes = 1024 * 1024, int maxFiles = 3);
+    void disableSlowQueryLog();
+    SlowQueryLog &getSlowQueryLog() { return slowLog; }
+
+    // Transaction (untuk operasi bulk, supaya tidak autocommit per row)
+    bool execute(const string &sql);
+    bool beginTransaction();
+    bool commitTransaction();
+    bool rollbackTransaction();
+    bool inTransaction() const; // false juga kalau SQLite sudah rollback otomatis
+
+    // Cursor: jalankan query dan panggil onRow untuk setiap row (return false = berhenti)
+    bool forEachRow(const string &sql, const function<bool(sqlite3_stmt *)> &onRow);
 
     // Komik Operations
     bool insertKomik(Komik *komik);
+    int insertKomiksBulk(const vector<Komik *> &komiks);
     bool updateKomik(int id, Komik *komik);
-    bool deleteKomik(int id);
+    bool deleteKomik(int id); // ikut hapus favorites komik ini (foreign_keys off)
     vector<Komik *> getAllKomiks();
+    // Keyset pagination: komik setelah (afterTitle, afterId), urut title lalu id
+    vector<Komik *> getKomiksPage(const string &afterTitle, int afterId, int limit);
+    int countKomiks();
     Komik *getKomikById(int id);
     int getLastKomikId();
+    TableFingerprint getKomiksFingerprint();
 
     // Genre Operations
     bool insertGenre(const string &name);
@@ -64,6 +124,8 @@ public:
     bool removeFavorite(const string &username, int komikId);
     vector<int> getFavoritesByUser(const string &username);
     bool isFavorite(const string &username, int komikId);
+    vector<pair<int, int>> getFavoriteCounts(); // hanya komik yang masih ada
+    vector<pair<string, int>> getAllFavorites();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <string>
+#include <vector>
+#include "Database.h"
+
+using namespace std;
+
+enum ExportFormat
+{
+    EXPORT_CSV,
+    EXPORT_JSONL
+};
+
+// Streaming export tabel komiks / users (tanpa password hash) / favorites.
+// Row dibaca pakai cursor dan ditulis lewat buffer besar (bukan endl per row),
+// jadi memory tetap kecil walaupun jumlah row jutaan.
+class Exporter
+{
+private:
+    Database &db;
+    size_t bufferSize;
+
+    static void appendJsonString(string &out, const char *text, int length);
+
+    bool exportQuery(const string &sql, const vector<string> &columns, ExportFormat format,
+                     const string &path, long &rows);
+
+public:
+    Exporter(Database &db);
+    ~Exporter();
+
+    // Tulis satu field CSV, di-quote hanya kalau perlu (dipakai juga oleh CatalogGenerator)
+    static void appendCsvField(string &out, const char *text, int length);
+
+    void setBufferSize(size_t bytes);
+
+    // table: "komiks", "users", atau "favorites"
+    bool exportTable(const string &table, ExportFormat format, const string &path, long &rows);
+
+    static bool parseFormat(const string &name, ExportFormat &format);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include <string>
+#include <vector>
+#include "BST.h"
+#include "KomikManager.h"
+#include "Database.h"
+
+using namespace std;
+
+struct ImportRow
+{
+    long line;
+    string title;
+    string author;
+    string genre;
+};
+
+struct ImportReport
+{
+    long rowsRead;
+    long imported;
+    long duplicates;
+    long rejected;
+    long newAuthors;
+    long newGenres;
+    double parseMs;
+    double insertMs;
+    double buildMs;
+    vector<string> errors;
+
+    ImportReport() : rowsRead(0), imported(0), duplicates(0), rejected(0),
+                     newAuthors(0), newGenres(0), parseMs(0), insertMs(0), buildMs(0) {}
+};
+
+// Bulk import komik dari file CSV (title,author,genre) atau JSONL
+// ({"title": ..., "author": ..., "genre": ...} per baris)
+// - Parsing dibagi ke beberapa worker thread (per potongan baris)
+// - Semua insert dalam SATU transaction dengan SATU prepared statement
+// - Tree dibangun ulang sekali di akhir (BST::bulkInsert)
+class Importer
+{
+private:
+    BST &tree;
+    KomikManager &manager;
+    Database &db;
+    int threadCount;
+    bool strict; // true: tolak author/genre yang belum terdaftar
+
+    static bool parseCsvLine(const string &line, vector<string> &fields);
+    static bool parseJsonLine(const string &line, vector<string> &fields);
+    static bool readJsonString(const string &line, size_t &pos, string &value);
+    static string normalizeGenres(const string &genreList, vector<string> &names);
+
+    static void parseChunk(const string &data, size_t begin, size_t end, long firstLine,
+                           bool json, vector<ImportRow> &rows, vector<string> &errors);
+
+public:
+    Importer(BST &tree, KomikManager &manager, Database &db);
+    ~Importer();
+
+    void setThreads(int count);
+    void setStrict(bool enabled);
+
+    bool importFile(const string &path, ImportReport &report);
+};
+
+#endif
@@ -43,7 +43,7 @@ struct Komik
         cout << "ID: " << id
              << " | Title: " << title
              << " | Author: " << author
-             << " | Genre: " << genre << endl;
+             << " | Genre: " << genre << '\n';
     }
 
     bool operator<(const Komik &other) const
@@ -4,9 +4,11 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 #include "Komik.h"
 #include "BST.h"
 #include "Database.h"
+#include "Recommender.h"
 
 using namespace std;
 
@@ -17,13 +19,37 @@ private:
     vector<string> authors;
     int nextId;
     Database *db;
+    bool verbose;
+
+    // Cache favorites per user (lazy load, write-through saat add/remove)
+    map<string, set<int>> favoritesCache;
+    set<int> &getFavoriteSet(const string &username);
+
+    // Popularity: jumlah favorite per komik + ranking (-count, komikId)
+    // supaya update dan ambil top-N cukup O(log n)
+    map<int, int> favoriteCounts;
+    set<pair<int, int>> popularityRank;
+    void loadFavoriteCounts();
+    void adjustFavoriteCount(int comicId, int delta);
+
+    // Co-favorite engine, di-build dari semua favorites saat rekomendasi
+    // pertama diminta (startup tetap lazy per user). Sebelum itu add/remove
+    // favorite tidak menyentuh recommender.
+    Recommender recommender;
+    bool recommenderLoaded;
+    void loadAllFavorites();
+    unsigned long long genreMask(const string &genreList) const;
 
 public:
     KomikManager(Database *database);
+    void setVerbose(bool enabled) { verbose = enabled; }
 
     // Load
     void loadDataFromDB(BST &tree);
 
+    // Buang tree + semua cache lalu load ulang dari database (misal setelah rollback)
+    void reloadFromDB(BST &tree);
+
     // ID
     int getNextId();
 
@@ -39,10 +65,25 @@ public:
     vector<string> getAllAuthors();
     void updateAuthor(const string &oldName, const string &newName, BST &tree);
 
-    // Favorites
-    void addFavorite(const string &username, int comicId);
-    void removeFavorite(const string &username, int comicId);
+    // Favorites (return true kalau berhasil / sudah jadi favorite)
+    bool addFavorite(const string &username, int comicId);
+    bool removeFavorite(const string &username, int comicId);
     vector<int> getFavoritesByUser(const string &username);
+    bool isFavorite(const string &username, int comicId);
+    void invalidateFavorites(const string &username);
+
+    // Komik dihapus: buang dari popularity, cache favorites, dan recommender
+    void forgetKomik(int comicId);
+
+    // Popularity
+    int getFavoriteCount(int comicId) const;
+    vector<pair<int, int>> getTopFavorited(int n) const;
+
+    // Recommendation
+    vector<Recommendation> getSimilarKomiks(int comicId, int k, BST &tree);
+
+    // Estimasi memory list genre/author, cache favorites, index popularity, recommender
+    void accountMemory(MemoryReport &report) const;
 
     // Helper sample data (dikososngkan saja)
     void loadSampleData(BST &tree) {}
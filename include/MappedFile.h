@@ -0,0 +1,39 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+// Read-only memory mapping untuk file (mmap / MapViewOfFile)
+class MappedFile
+{
+private:
+    const char *data;
+    size_t length;
+
+#ifdef _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#else
+    int fd;
+#endif
+
+    // Tidak boleh di-copy (mapping dimiliki satu object)
+    MappedFile(const MappedFile &);
+    MappedFile &operator=(const MappedFile &);
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const string &path);
+    void close();
+    bool isOpen() const;
+
+    const char *getData() const { return data; }
+    size_t size() const { return length; }
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+
+struct MemoryLine
+{
+    string category;
+    size_t objects;
+    size_t bytes;
+};
+
+// Akuntansi memory struktur in-memory (tree, manager, auth, index).
+// Angka adalah ESTIMASI layout libstdc++ 64-bit + allocator glibc: setiap
+// blok heap dibulatkan ke 16 byte + 8 byte header (minimal 32 byte), node
+// map/set punya header red-black 32 byte, node unordered_map 1 pointer next.
+// Setiap class menambahkan baris miliknya sendiri lewat accountMemory().
+class MemoryReport
+{
+private:
+    vector<MemoryLine> lines;
+    size_t heapStrings;
+    size_t inlineStrings;
+    size_t stringHeapBytes;
+
+public:
+    MemoryReport();
+
+    // Ukuran blok yang benar-benar diambil allocator untuk request n byte
+    static size_t heapBlock(size_t requested);
+
+    // Byte heap milik string (0 kalau masih muat di buffer SSO), sekaligus
+    // dicatat di statistik string heap vs SSO
+    size_t stringBytes(const string &text);
+
+    // Estimasi per node container (tanpa isi heap elemen)
+    template <typename K, typename V>
+    static size_t mapNodeBytes(const map<K, V> &) { return heapBlock(32 + sizeof(pair<const K, V>)); }
+    template <typename T>
+    static size_t setNodeBytes(const set<T> &) { return heapBlock(32 + sizeof(T)); }
+    template <typename K, typename V>
+    static size_t unorderedBytes(const unordered_map<K, V> &table)
+    {
+        return table.size() * heapBlock(sizeof(void *) + sizeof(pair<const K, V>)) +
+               heapBlock(table.bucket_count() * sizeof(void *));
+    }
+    template <typename T>
+    static size_t vectorBytes(const vector<T> &items)
+    {
+        return items.capacity() ? heapBlock(items.capacity() * sizeof(T)) : 0;
+    }
+
+    void add(const string &category, size_t objects, size_t bytes);
+
+    const vector<MemoryLine> &getLines() const { return lines; }
+    size_t totalBytes() const;
+    size_t getHeapStrings() const { return heapStrings; }
+    size_t getInlineStrings() const { return inlineStrings; }
+    size_t getStringHeapBytes() const { return stringHeapBytes; }
+
+    // Tabel kategori + ringkasan string ke stdout
+    void print() const;
+};
+
+#endif
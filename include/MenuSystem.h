@@ -26,6 +26,8 @@ public:
     void myFavoritesMenu();
     void viewComicsMenu();
     void userManagementMenu();
+    void topFavoritesMenu();
+    void recommendationsMenu();
 
     bool handleLogin();
     bool handleRegister();
@@ -0,0 +1,127 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+using namespace std;
+
+// Instrumentasi hot path: timer per scope, counter, dan histogram latency.
+// Aktif secara default; compile dengan -DKOMIK_NO_METRICS supaya semua macro
+// METRIC_* jadi kosong (nol overhead). Recording hanya atomic relaxed tanpa
+// lock, jadi aman dipanggil dari worker thread server / SearchFilter.
+
+// Histogram: 4 sub-bucket per pangkat 2 (error estimasi percentile <= ~12%)
+const int METRIC_BUCKETS = 252;
+
+struct MetricSlot
+{
+    string name;
+    atomic<unsigned long long> count;
+    atomic<unsigned long long> totalNs;
+    atomic<unsigned long long> maxNs;
+    atomic<unsigned long long> buckets[METRIC_BUCKETS];
+
+    MetricSlot(const string &name);
+    void record(unsigned long long ns);
+    void reset();
+
+private:
+    MetricSlot(const MetricSlot &);
+    MetricSlot &operator=(const MetricSlot &);
+};
+
+struct MetricSnapshot
+{
+    string name;
+    unsigned long long count;
+    unsigned long long totalNs;
+    unsigned long long maxNs;
+    bool timed; // false = counter saja (tanpa latency)
+    double p50Ns;
+    double p95Ns;
+    double p99Ns;
+};
+
+class Metrics
+{
+private:
+    mutex registryMutex;
+    vector<MetricSlot *> slots;
+
+    Metrics();
+    ~Metrics();
+    Metrics(const Metrics &);
+    Metrics &operator=(const Metrics &);
+
+public:
+    static Metrics &instance();
+    static bool enabled();
+
+    // Slot dicari / dibuat sekali per call site (lihat macro), lalu dipakai langsung
+    MetricSlot *slot(const string &name);
+
+    // Urut nama; slot yang belum pernah tercatat dilewati
+    vector<MetricSnapshot> snapshot();
+    void reset();
+
+    static int bucketIndex(unsigned long long ns);
+    static double bucketValue(int index);
+};
+
+// Catat durasi dari konstruksi sampai akhir scope
+class ScopedTimer
+{
+private:
+    MetricSlot *slot;
+    chrono::steady_clock::time_point start;
+
+    ScopedTimer(const ScopedTimer &);
+    ScopedTimer &operator=(const ScopedTimer &);
+
+public:
+    ScopedTimer(MetricSlot *slot) : slot(slot), start(chrono::steady_clock::now()) {}
+    ~ScopedTimer()
+    {
+        slot->record((unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+                         chrono::steady_clock::now() - start)
+                         .count());
+    }
+};
+
+#define METRIC_CONCAT_INNER(a, b) a##b
+#define METRIC_CONCAT(a, b) METRIC_CONCAT_INNER(a, b)
+
+#ifndef KOMIK_NO_METRICS
+
+// Static lokal: lookup nama hanya sekali per call site (thread-safe di C++11)
+#define METRIC_TIMER(name)                                                                        \
+    static MetricSlot *METRIC_CONCAT(metricSlot_, __LINE__) = Metrics::instance().slot(name); \
+    ScopedTimer METRIC_CONCAT(metricTimer_, __LINE__)(METRIC_CONCAT(metricSlot_, __LINE__))
+
+#define METRIC_ADD(name, n)                                                                   \
+    do                                                                                        \
+    {                                                                                         \
+        static MetricSlot *metricCounter = Metrics::instance().slot(name);                    \
+        metricCounter->count.fetch_add((unsigned long long)(n), memory_order_relaxed);        \
+    } while (0)
+
+#else
+
+#define METRIC_TIMER(name) \
+    do                     \
+    {                      \
+    } while (0)
+#define METRIC_ADD(name, n) \
+    do                      \
+    {                       \
+    } while (0)
+
+#endif
+
+#define METRIC_COUNT(name) METRIC_ADD(name, 1)
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef PERSISTENTBST_H
+#define PERSISTENTBST_H
+
+#include "Komik.h"
+#include "BST.h"
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+// Node immutable: setelah dipublish tidak pernah diubah lagi
+struct PersistentNode
+{
+    Komik komik; // left/right Komik tidak dipakai (selalu nullptr)
+    shared_ptr<const PersistentNode> left;
+    shared_ptr<const PersistentNode> right;
+    size_t size; // jumlah node di subtree ini
+
+    PersistentNode(const Komik &data, const shared_ptr<const PersistentNode> &l, const shared_ptr<const PersistentNode> &r)
+        : komik(data.id, data.title, data.author, data.genre), left(l), right(r),
+          size(1 + (l ? l->size : 0) + (r ? r->size : 0)) {}
+};
+
+typedef shared_ptr<const PersistentNode> PersistentNodePtr;
+
+// BST persistent (path copying). Writer menyalin jalur root -> node yang
+// berubah lalu mempublish root baru secara atomic; node lain dipakai
+// bersama antar versi. Reader mengambil Version (shared_ptr ke root) dan
+// bisa membacanya selama apapun tanpa lock. Node lama otomatis dibebaskan
+// saat Version terakhir yang memegangnya dilepas.
+class PersistentBST
+{
+public:
+    // Snapshot immutable dari tree pada satu titik waktu
+    class Version
+    {
+    private:
+        PersistentNodePtr root;
+        unsigned long long number;
+
+    public:
+        Version() : number(0) {}
+        Version(const PersistentNodePtr &root, unsigned long long number) : root(root), number(number) {}
+
+        bool search(const string &title, Komik &result) const;
+        vector<Komik> searchPartial(const string &keyword) const;
+        vector<Komik> getAllKomiks() const;
+        vector<Komik> collectAfter(const Komik *after, size_t limit) const;
+        void inOrder(const function<void(const Komik &)> &callback) const;
+
+        size_t count() const { return root ? root->size : 0; }
+        bool isEmpty() const { return !root; }
+        unsigned long long getNumber() const { return number; }
+        const PersistentNodePtr &getRoot() const { return root; }
+    };
+
+private:
+    // Versi yang sedang dipublish, diakses hanya lewat atomic_load / atomic_store
+    shared_ptr<const Version> current;
+    mutex writerMutex; // writer diserialkan, reader tidak pernah lock
+
+    static PersistentNodePtr insertHelper(const PersistentNodePtr &node, const Komik &komik);
+    static PersistentNodePtr removeHelper(const PersistentNodePtr &node, const string &title, bool &removed);
+    static PersistentNodePtr removeMin(const PersistentNodePtr &node, Komik &minKomik);
+    static PersistentNodePtr buildBalanced(const vector<Komik *> &komiks, int low, int high);
+
+    PersistentNodePtr currentRoot() const;
+    void publish(const PersistentNodePtr &newRoot);
+
+    PersistentBST(const PersistentBST &);
+    PersistentBST &operator=(const PersistentBST &);
+
+public:
+    PersistentBST();
+
+    // Snapshot terbaru (wait-free untuk reader, cukup atomic_load)
+    Version snapshot() const;
+
+    // Writers: satu publish per operasi
+    void insert(const Komik &komik);
+    bool remove(const string &title);
+    bool update(const string &oldTitle, const Komik &updated); // remove + insert, satu versi
+    void loadFrom(const BST &tree);
+    void clear();
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef QUERYRUNNER_H
+#define QUERYRUNNER_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <sqlite3.h>
+
+using namespace std;
+
+// Ringkasan eksekusi satu query ad-hoc
+struct QueryStats
+{
+    long rows;
+    bool truncated; // berhenti karena batas jumlah row
+    bool timedOut;  // dihentikan progress handler (batas waktu)
+    double prepareMs;
+    double stepMs;
+
+    QueryStats() : rows(0), truncated(false), timedOut(false), prepareMs(0), stepMs(0) {}
+};
+
+// Eksekutor SQL ad-hoc lewat koneksi SQLITE_OPEN_READONLY terpisah.
+// Hanya statement yang sqlite3_stmt_readonly() yang dijalankan, row di-stream
+// ke callback (tidak ditampung), dengan batas jumlah row dan batas waktu.
+class QueryRunner
+{
+private:
+    sqlite3 *db;
+    int timeLimitMs;
+    chrono::steady_clock::time_point deadline;
+
+    static int progressCallback(void *self);
+
+    QueryRunner(const QueryRunner &);
+    QueryRunner &operator=(const QueryRunner &);
+
+public:
+    QueryRunner();
+    ~QueryRunner();
+
+    bool open(const string &path);
+    void close();
+    bool isOpen() const;
+
+    void setTimeLimit(int milliseconds) { timeLimitMs = milliseconds; }
+
+    // onColumns dipanggil sekali dengan nama kolom, onRow untuk setiap row.
+    // Return false kalau query ditolak / gagal (pesan ke cerr).
+    bool run(const string &sql, long maxRows,
+             const function<void(const vector<string> &)> &onColumns,
+             const function<void(sqlite3_stmt *)> &onRow,
+             QueryStats &stats);
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+// Reader/writer lock untuk C++11 (std::shared_mutex baru ada di C++17).
+// Banyak reader boleh jalan bersamaan, writer eksklusif. Writer yang
+// menunggu diprioritaskan supaya tidak kelaparan oleh arus reader.
+class RWLock
+{
+private:
+    mutex m;
+    condition_variable readersCv;
+    condition_variable writersCv;
+    int activeReaders;
+    int waitingWriters;
+    bool writerActive;
+
+    RWLock(const RWLock &);
+    RWLock &operator=(const RWLock &);
+
+public:
+    RWLock();
+
+    void lockShared();
+    void unlockShared();
+    void lock();
+    void unlock();
+};
+
+// RAII guard: shared (reader)
+class ReadGuard
+{
+private:
+    RWLock &rw;
+
+public:
+    explicit ReadGuard(RWLock &lock) : rw(lock) { rw.lockShared(); }
+    ~ReadGuard() { rw.unlockShared(); }
+};
+
+// RAII guard: exclusive (writer)
+class WriteGuard
+{
+private:
+    RWLock &rw;
+
+public:
+    explicit WriteGuard(RWLock &lock) : rw(lock) { rw.lock(); }
+    ~WriteGuard() { rw.unlock(); }
+};
+
+#endif
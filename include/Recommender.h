@@ -0,0 +1,44 @@
+#ifndef RECOMMENDER_H
+#define RECOMMENDER_H
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+
+class MemoryReport;
+
+struct Recommendation
+{
+    int comicId;
+    int sharedFans;   // jumlah user yang memfavoritkan keduanya
+    int sharedGenres; // jumlah genre yang sama (tie-breaker)
+};
+
+// Item-to-item co-occurrence dari tabel favorites
+// coCounts[a][b] = jumlah user yang memfavoritkan komik a DAN komik b
+class Recommender
+{
+private:
+    unordered_map<int, unordered_map<int, int>> coCounts;
+
+    void link(int a, int b, int delta);
+
+public:
+    Recommender();
+    ~Recommender();
+
+    void clear();
+    void accountMemory(MemoryReport &report) const;
+
+    // Dipanggil dengan set favorites user SEBELUM komik ditambah / SESUDAH komik dihapus
+    void onFavoriteAdded(const set<int> &userFavorites, int comicId);
+    void onFavoriteRemoved(const set<int> &userFavorites, int comicId);
+
+    // Semua komik yang pernah difavoritkan bersama comicId: pair (komikId, co-count)
+    vector<pair<int, int>> getCoFavorites(int comicId) const;
+    int getCoCount(int a, int b) const;
+};
+
+#endif
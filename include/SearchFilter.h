@@ -3,8 +3,13 @@
 
 #include <string>
 #include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "BST.h"
 #include "Komik.h"
+#include "CatalogImage.h"
 
 using namespace std;
 
@@ -12,14 +17,46 @@ class SearchFilter {
 private:
     // Helper methods (Internal)
     string toLowerCase(const string& str);
-    bool containsIgnoreCase(const string& str1, const string& str2);
-    void dfsSearchHelper(Komik* node, const string& title, vector<Komik*>& results);
+
+    // Scan serial = traversal in-order langsung (tanpa copy tree). Parallel
+    // scan: tree di-flatten (in-order) lalu dibagi per chunk ke worker pool;
+    // hasil digabung per urutan chunk jadi tetap urut title.
+    // Di bawah parallelThreshold komik tetap serial.
+    unsigned threadCount;
+    size_t parallelThreshold;
+    vector<Komik*> scanTree(BST& tree, const function<bool(const Komik*)>& match);
+
+    // Worker pool persistent: dibuat sekali saat scan paralel pertama, dipakai
+    // ulang sampai SearchFilter dihancurkan. Caller mengerjakan task 0,
+    // worker ke-i mengerjakan task i.
+    vector<thread> workers;
+    mutex poolMutex;
+    mutex scanMutex; // satu scan paralel dalam satu waktu per SearchFilter
+    condition_variable poolCv;
+    condition_variable poolDoneCv;
+    const function<void(unsigned)>* poolTask;
+    unsigned poolTaskCount;
+    unsigned poolPending;
+    unsigned long long poolGeneration;
+    bool poolStopping;
+    void startPool(unsigned threads);
+    void stopPool();
+    void poolWorker(unsigned index);
+    void runOnPool(unsigned tasks, const function<void(unsigned)>& task);
+
+    vector<size_t> scanCatalog(const CatalogImage& image, const function<bool(const CatalogEntry&)>& match);
+
+    SearchFilter(const SearchFilter&);
+    SearchFilter& operator=(const SearchFilter&);
 
 public:
     // Constructor & Destructor
     SearchFilter();
     ~SearchFilter();
 
+    // threads = 0 berarti pakai jumlah core (hardware_concurrency)
+    void setParallelism(unsigned threads, size_t threshold);
+
     // Main Search & Filter methods
     vector<Komik*> searchByTitle(BST& tree, const string& title);
     vector<Komik*> searchByAuthor(BST& tree, const string& author);
@@ -30,8 +67,15 @@ public:
     vector<Komik*> filterByAuthor(BST& tree, const string& author);
     vector<Komik*> filterByMultiple(BST& tree, const string& genre, const string& author);
 
+    // Versi katalog read-only (memory-mapped), hasil = index record di katalog
+    vector<size_t> searchByTitle(const CatalogImage& image, const string& title);
+    vector<size_t> searchByAuthor(const CatalogImage& image, const string& author);
+    vector<size_t> searchByGenre(const CatalogImage& image, const string& genre);
+    vector<size_t> filterByMultiple(const CatalogImage& image, const string& genre, const string& author);
+
     // Display
     void displayResults(const vector<Komik*>& results, const string& message);
+    void displayResults(const CatalogImage& image, const vector<size_t>& results, const string& message);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef SLOWQUERYLOG_H
+#define SLOWQUERYLOG_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+#include <sqlite3.h>
+
+using namespace std;
+
+struct SlowQueryTrace;
+
+// Log statement SQLite yang lebih lambat dari threshold. Waktu diukur lewat
+// sqlite3_trace_v2 per koneksi (STMT = mulai, PROFILE = selesai; resolusi
+// PROFILE bawaan SQLite hanya ms), SQL ditulis lengkap dengan parameter
+// yang di-bind (sqlite3_expanded_sql). File dirotasi saat
+// melewati maxBytes: log -> log.1 -> log.2 ... (maksimal maxFiles file lama).
+class SlowQueryLog
+{
+private:
+    mutex m;
+    string path;
+    FILE *file;
+    long fileBytes;
+    double thresholdMs;
+    long maxBytes;
+    int maxFiles;
+    unsigned long long logged;
+    vector<SlowQueryTrace *> traces; // context callback per koneksi
+
+    // Statement yang sedang jalan: waktu mulai + total_changes koneksi saat mulai
+    struct Running
+    {
+        chrono::steady_clock::time_point start;
+        int totalChanges;
+    };
+    unordered_map<sqlite3_stmt *, Running> running;
+
+    static int traceCallback(unsigned type, void *context, void *statement, void *elapsedNs);
+    void begin(sqlite3_stmt *stmt);
+    void finish(sqlite3_stmt *stmt, long long sqliteNs, const char *connection);
+    void rotate();
+
+    SlowQueryLog(const SlowQueryLog &);
+    SlowQueryLog &operator=(const SlowQueryLog &);
+
+public:
+    SlowQueryLog();
+    ~SlowQueryLog();
+
+    // thresholdMs = 0 berarti semua statement dicatat
+    bool open(const string &path, double thresholdMs, long maxBytes = 1024 * 1024, int maxFiles = 3);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Pasang / lepas trace di satu koneksi. label muncul di setiap baris log
+    // (mis. "main" atau "writer"); harus string literal / tetap hidup.
+    // Koneksi harus di-detach sebelum SlowQueryLog dihancurkan.
+    void attach(sqlite3 *conn, const char *label);
+    static void detach(sqlite3 *conn);
+
+    double getThresholdMs() const { return thresholdMs; }
+    const string &getPath() const { return path; }
+    unsigned long long getLoggedCount();
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <cstdint>
+#include "BST.h"
+#include "Database.h"
+
+using namespace std;
+
+// ===== FORMAT FILE SNAPSHOT =====
+// [SnapshotHeader][SnapshotRecord x nodeCount][string pool]
+// - Record urut in-order (title -> author -> genre), jadi bisa langsung
+//   dibangun jadi tree seimbang tanpa insert satu per satu
+// - String pool: setiap string = uint32 panjang + byte string,
+//   record menyimpan offset ke pool (author/genre yang sama cuma disimpan sekali)
+// - Checksum FNV-1a 64-bit atas record + pool
+
+const char SNAPSHOT_MAGIC[8] = {'K', 'M', 'K', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t nodeCount;
+    uint64_t poolSize;
+    uint64_t checksum;
+
+    // Fingerprint tabel komiks saat snapshot ditulis
+    int64_t dbRowCount;
+    int64_t dbMaxId;
+    int64_t dbPayloadBytes;
+    uint32_t dbChangeCounter;
+    uint32_t reserved2;
+};
+
+struct SnapshotRecord
+{
+    int32_t id;
+    uint32_t titleOffset;
+    uint32_t authorOffset;
+    uint32_t genreOffset;
+};
+
+class Snapshot
+{
+public:
+    // Tulis isi tree ke file (hanya kalau tree sama dengan tabel komiks)
+    static bool save(const string &path, const BST &tree, Database &db);
+
+    // Load tree dari file; return false kalau file tidak ada / rusak / basi
+    static bool load(const string &path, BST &tree, Database &db);
+
+    // Validasi header + layout file: magic/version, nodeCount dibatasi ukuran
+    // file sebelum dikali (anti overflow), dan header + record + pool = ukuran file.
+    // Return false + alasan di error kalau file tidak valid
+    static bool readHeader(const char *data, uint64_t fileSize, SnapshotHeader &header, string &error);
+
+    static uint64_t checksum(const char *data, size_t length, uint64_t seed = 14695981039346656037ULL);
+
+    // Baca string dari pool (offset menunjuk ke prefix panjang)
+    static bool readString(const char *pool, uint64_t poolSize, uint32_t offset,
+                           const char *&str, uint32_t &length);
+};
+
+#endif
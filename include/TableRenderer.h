@@ -0,0 +1,52 @@
+#ifndef TABLERENDERER_H
+#define TABLERENDERER_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "Komik.h"
+
+using namespace std;
+
+// Render tabel ke buffer string (tanpa setw/endl per cell), lalu ditulis
+// ke output sekaligus saat flush(). Buffer dipakai ulang antar layar.
+class TableRenderer
+{
+private:
+    ostream *out;
+    string buffer;
+    vector<int> widths;
+    size_t column;
+    size_t autoFlushBytes;
+
+    void pad(size_t written);
+    void maybeFlush();
+
+public:
+    TableRenderer(ostream &output = cout);
+    ~TableRenderer();
+
+    void setColumns(const vector<int> &columnWidths);
+
+    // Cell rata kiri dengan lebar kolom (sama seperti left << setw)
+    TableRenderer &cell(const string &text);
+    TableRenderer &cell(const char *text, size_t length);
+    TableRenderer &cell(long long value);
+    void endRow();
+
+    void headerRow(const vector<string> &names);
+    void separator(int width, char c = '-');
+    void text(const string &str);
+    void number(long long value);
+
+    // Format standar komik: tabel ID | Title | Author | Genre(s) (lebar 5/30/25/20)
+    void komikHeader(const string &genreLabel = "Genre(s)");
+    void komikRow(const Komik *comic);
+    // Format satu baris seperti Komik::display()
+    void komikLine(const Komik *comic);
+
+    void flush();
+    void clear();
+};
+
+#endif
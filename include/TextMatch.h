@@ -0,0 +1,54 @@
+#ifndef TEXTMATCH_H
+#define TEXTMATCH_H
+
+#include <string>
+#include <cctype>
+
+using namespace std;
+
+// Pencocokan teks case-insensitive tanpa alokasi, dipakai bersama BST,
+// SearchFilter, dan PersistentBST. Keyword harus sudah lowercase (cukup
+// di-lowercase sekali per query); text dibandingkan langsung per karakter.
+
+// true kalau lowerKeyword muncul di text[0..length) (keyword kosong = selalu true)
+inline bool containsLowered(const char *text, size_t length, const string &lowerKeyword)
+{
+    if (lowerKeyword.empty())
+        return true;
+    if (lowerKeyword.size() > length)
+        return false;
+
+    for (size_t start = 0; start + lowerKeyword.size() <= length; start++)
+    {
+        size_t i = 0;
+        while (i < lowerKeyword.size() &&
+               tolower((unsigned char)text[start + i]) == (unsigned char)lowerKeyword[i])
+        {
+            i++;
+        }
+        if (i == lowerKeyword.size())
+            return true;
+    }
+    return false;
+}
+
+inline bool containsLowered(const string &text, const string &lowerKeyword)
+{
+    return containsLowered(text.data(), text.size(), lowerKeyword);
+}
+
+// true kalau text sama persis dengan lowerKeyword (abaikan huruf besar/kecil)
+inline bool equalsLowered(const string &text, const string &lowerKeyword)
+{
+    if (text.size() != lowerKeyword.size())
+        return false;
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (tolower((unsigned char)text[i]) != (unsigned char)lowerKeyword[i])
+            return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef WRITEBEHINDQUEUE_H
+#define WRITEBEHINDQUEUE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <sqlite3.h>
+#include "SlowQueryLog.h"
+
+using namespace std;
+
+// Jenis mutation, menentukan aturan coalescing untuk key yang sama
+enum WriteKind
+{
+    WRITE_INSERT, // tidak pernah digantikan oleh UPDATE (row harus tetap dibuat)
+    WRITE_UPDATE, // UPDATE berikutnya / DELETE menggantikan yang lama
+    WRITE_DELETE, // menggantikan apapun yang masih antre untuk key ini
+    WRITE_SET     // state akhir saja yang penting (misal favorite add/remove)
+};
+
+struct WriteParam
+{
+    bool isText;
+    long long number;
+    string text;
+};
+
+// Satu mutation: SQL dengan placeholder '?' + parameter yang sudah di-copy
+struct WriteRecord
+{
+    WriteKind kind;
+    string key; // target row, misal "komik:12" atau "fav:user\t12"
+    const char *sql;
+    const char *errorLabel;
+    vector<WriteParam> params;
+    unsigned long long seq;
+    bool superseded;
+
+    WriteRecord(WriteKind kind, const string &key, const char *sql, const char *errorLabel)
+        : kind(kind), key(key), sql(sql), errorLabel(errorLabel), seq(0), superseded(false) {}
+
+    WriteRecord &bind(long long value);
+    WriteRecord &bind(const string &value);
+
+    // Prepare + bind + step di koneksi yang diberikan
+    bool apply(sqlite3 *conn, string &error) const;
+};
+
+// Write-behind: mutation diantre lalu di-commit oleh background thread
+// (koneksi SQLite sendiri) dalam satu transaction per interval. Mutation
+// ke key yang sama selama masih antre di-coalesce.
+class WriteBehindQueue
+{
+private:
+    sqlite3 *conn;
+    SlowQueryLog *slowLog;
+    thread worker;
+    mutable mutex m;
+    condition_variable workCv;
+    condition_variable doneCv;
+
+    vector<WriteRecord> pending;
+    map<string, size_t> pendingByKey; // key -> index record terakhir di pending
+    unsigned long long nextSeq;
+    unsigned long long committedSeq;
+    set<unsigned long long> failedSeqs; // hanya dicatat untuk durable ack
+
+    bool running;
+    bool stopping;
+    bool flushRequested;
+    bool durableAck;
+    int intervalMs;
+
+    long long batches;
+    long long applied;
+    long long coalesced;
+
+    // Write yang sudah di-ack tapi dibuang (error selain BUSY); dilaporkan
+    // lewat return flush() berikutnya
+    long long discarded;
+    long long discardedReported;
+    string lastError;
+
+    void run();
+    // false = batch belum ditulis sama sekali (database sibuk), harus diantre ulang
+    bool commitBatch(vector<WriteRecord> &batch);
+    void requeue(vector<WriteRecord> &batch);
+
+    WriteBehindQueue(const WriteBehindQueue &);
+    WriteBehindQueue &operator=(const WriteBehindQueue &);
+
+public:
+    WriteBehindQueue();
+    ~WriteBehindQueue();
+
+    bool start(const string &path, int intervalMs, bool durableAck);
+    void stop(); // flush semua yang antre lalu join thread
+    bool isRunning() const { return running; }
+
+    // Trace koneksi writer ke slow query log (nullptr = tidak dicatat)
+    void setSlowQueryLog(SlowQueryLog *log);
+
+    // Non-durable: langsung return true. Durable: tunggu commit, return hasilnya.
+    bool submit(WriteRecord record);
+
+    // Tunggu sampai semua mutation yang sudah di-submit ter-commit.
+    // false kalau sejak flush sebelumnya ada write non-durable yang dibuang (lihat getLastError)
+    bool flush();
+
+    long long getBatchCount() const;
+    long long getAppliedCount() const;
+    long long getCoalescedCount() const;
+    long long getDiscardedCount() const;
+    string getLastError() const;
+};
+
+#endif
@@ -11,6 +11,25 @@
 #include "include/MenuSystem.h"
 #include "include/SearchFilter.h"
 #include "include/Database.h"
+#include "include/Recommender.h"
+#include "include/MappedFile.h"
+#include "include/Snapshot.h"
+#include "include/CatalogImage.h"
+#include "include/BatchRunner.h"
+#include "include/Importer.h"
+#include "include/Exporter.h"
+#include "include/WriteBehindQueue.h"
+#include "include/TableRenderer.h"
+#include "include/QueryRunner.h"
+#include "include/RWLock.h"
+#include "include/ConcurrentCatalog.h"
+#include "include/PersistentBST.h"
+#include "include/CatalogServer.h"
+#include "include/CatalogGenerator.h"
+#include "include/Metrics.h"
+#include "include/SlowQueryLog.h"
+#include "include/MemoryReport.h"
+#include "include/TextMatch.h"
 
 // ===== INCLUDE IMPLEMENTATION FILES =====
 #include "src/BST.cpp"
@@ -19,12 +38,34 @@
 #include "src/Auth.cpp"
 #include "src/SearchFilter.cpp"
 #include "src/Database.cpp"
+#include "src/Recommender.cpp"
+#include "src/MappedFile.cpp"
+#include "src/Snapshot.cpp"
+#include "src/CatalogImage.cpp"
+#include "src/BatchRunner.cpp"
+#include "src/Importer.cpp"
+#include "src/Exporter.cpp"
+#include "src/WriteBehindQueue.cpp"
+#include "src/TableRenderer.cpp"
+#include "src/QueryRunner.cpp"
+#include "src/RWLock.cpp"
+#include "src/ConcurrentCatalog.cpp"
+#include "src/PersistentBST.cpp"
+#include "src/CatalogServer.cpp"
+#include "src/CatalogGenerator.cpp"
+#include "src/Metrics.cpp"
+#include "src/SlowQueryLog.cpp"
+#include "src/MemoryReport.cpp"
 
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <sstream>
 #include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <unordered_map>
+#include <csignal>
 
 using namespace std;
 
@@ -37,6 +78,13 @@ void crudGenreMenu(KomikManager &manager, BST &tree);
 void crudAuthorMenu(KomikManager &manager, BST &tree);
 void traversalMenu(BST &tree);
 void viewFavoritesMenu(KomikManager &manager, BST &tree);
+void browseKomikPages(BST &tree, const string &title);
+int runKioskMode(const string &catalogPath);
+int runBatchMode(const string &batchPath, int groupSize);
+int runImportMode(const string &importPath, int threads, bool strict);
+int runExportMode(const string &table, const string &format, const string &outPath);
+int runServerMode(const string &socketPath, int threads);
+int runGenerateMode(const string &outPath, const GeneratorConfig &config, bool userDataRequested);
 
 // Helper functions
 vector<int> parseGenreChoices(const string &input);
@@ -46,7 +94,48 @@ string getAuthorFromList(KomikManager &manager, bool allowEmpty = false);
 // Global database connection
 Database dbConnection;
 
-void databaseInspectorMenu(Database &db, BST &tree)
+// File snapshot tree (ditulis saat exit, dibaca saat startup)
+const string SNAPSHOT_FILE = "komik_snapshot.bin";
+
+// Slow query log (mode interaktif dan server); threshold bisa diubah dengan --slow-ms N
+const string SLOW_QUERY_LOG = "komik_slow.log";
+double slowQueryMs = 50;
+
+// Prompt navigasi halaman (dipakai browse tree dan inspector)
+enum PageCommand
+{
+    PAGE_QUIT,
+    PAGE_NEXT,
+    PAGE_PREV,
+    PAGE_STAY
+};
+
+PageCommand readPageCommand(TableRenderer &table, size_t page, size_t totalPages, size_t total, bool hasNext)
+{
+    table.text("\nPage ");
+    table.number(page + 1);
+    table.text("/");
+    table.number(totalPages);
+    table.text(" | Total: ");
+    table.number(total);
+    table.text(" records\n[Enter/n] Next  [p] Prev  [q] Back: ");
+    table.flush();
+
+    string command;
+    if (!getline(cin, command) || command == "q" || command == "Q")
+        return PAGE_QUIT;
+
+    if (command == "p" || command == "P")
+        return page > 0 ? PAGE_PREV : PAGE_STAY;
+
+    if (hasNext)
+        return PAGE_NEXT;
+
+    // Enter di halaman terakhir = selesai
+    return command.empty() ? PAGE_QUIT : PAGE_STAY;
+}
+
+void databaseInspectorMenu(Database &db, BST &tree, KomikManager &manager, Auth &auth)
 {
     int choice;
 
@@ -61,6 +150,10 @@ void databaseInspectorMenu(Database &db, BST &tree)
         cout << "5. View Favorites Table\n";
         cout << "6. Database Statistics\n";
         cout << "7. Run Custom SQL Query\n";
+        cout << "8. Export Table (CSV/JSONL)\n";
+        cout << "9. Performance Metrics\n";
+        cout << "10. Tree Shape Diagnostics\n";
+        cout << "11. Memory Report\n";
         cout << "0. Back\n";
         cout << "\nChoice: ";
 
@@ -71,32 +164,60 @@ void databaseInspectorMenu(Database &db, BST &tree)
         {
         case 1:
         {
-            printHeader("KOMIKS TABLE");
-            vector<Komik *> komiks = db.getAllKomiks();
+            const int PAGE_SIZE = 20;
+            size_t total = db.countKomiks();
 
-            if (komiks.empty())
+            if (total == 0)
             {
+                printHeader("KOMIKS TABLE");
                 cout << "\033[33mNo data in komiks table!\033[0m" << endl;
+                pause();
+                break;
             }
-            else
+
+            // Keyset pagination: simpan (title, id) terakhir dari tiap halaman
+            size_t totalPages = (total + PAGE_SIZE - 1) / PAGE_SIZE;
+            vector<pair<string, int>> pageStarts;
+            size_t page = 0;
+            TableRenderer table;
+
+            while (true)
             {
-                cout << left << setw(5) << "ID"
-                     << setw(30) << "Title"
-                     << setw(25) << "Author"
-                     << setw(20) << "Genre(s)" << endl;
-                cout << string(80, '-') << endl;
+                string afterTitle = page == 0 ? "" : pageStarts[page - 1].first;
+                int afterId = page == 0 ? 0 : pageStarts[page - 1].second;
+                vector<Komik *> komiks = db.getKomiksPage(afterTitle, afterId, PAGE_SIZE + 1);
+                bool hasNext = komiks.size() > (size_t)PAGE_SIZE;
+                if (hasNext)
+                {
+                    delete komiks.back();
+                    komiks.pop_back();
+                }
 
+                printHeader("KOMIKS TABLE");
+                table.komikHeader();
                 for (Komik *k : komiks)
                 {
-                    cout << left << setw(5) << k->id
-                         << setw(30) << k->title
-                         << setw(25) << k->author
-                         << setw(20) << k->genre << endl;
+                    table.komikRow(k);
+                }
+
+                PageCommand command = readPageCommand(table, page, totalPages, total, hasNext);
+                if (command == PAGE_NEXT && pageStarts.size() == page)
+                {
+                    pageStarts.push_back(make_pair(komiks.back()->title, komiks.back()->id));
                 }
 
-                cout << "\nTotal records: " << komiks.size() << endl;
+                for (Komik *k : komiks)
+                {
+                    delete k;
+                }
+
+                if (command == PAGE_QUIT)
+                    break;
+                if (command == PAGE_PREV)
+                    page--;
+                else if (command == PAGE_NEXT)
+                    page++;
             }
-            pause();
             break;
         }
 
@@ -111,21 +232,21 @@ void databaseInspectorMenu(Database &db, BST &tree)
             }
             else
             {
-                cout << left << setw(5) << "ID"
-                     << setw(20) << "Username"
-                     << setw(40) << "Password (Hashed)"
-                     << setw(10) << "Role" << endl;
-                cout << string(75, '-') << endl;
+                TableRenderer table;
+                table.setColumns({5, 20, 40, 10});
+                table.headerRow({"ID", "Username", "Password (Hashed)", "Role"});
+                table.separator(75);
 
                 for (const User &u : users)
                 {
-                    cout << left << setw(5) << u.id
-                         << setw(20) << u.username
-                         << setw(40) << u.password.substr(0, 37) + "..."
-                         << setw(10) << u.role << endl;
+                    table.cell(u.id).cell(u.username).cell(u.password.substr(0, 37) + "...").cell(u.role);
+                    table.endRow();
                 }
 
-                cout << "\nTotal records: " << users.size() << endl;
+                table.text("\nTotal records: ");
+                table.number(users.size());
+                table.text("\n");
+                table.flush();
             }
             pause();
             break;
@@ -184,10 +305,15 @@ void databaseInspectorMenu(Database &db, BST &tree)
             vector<User> users = db.getAllUsers();
             bool hasAnyFavorites = false;
 
-            cout << left << setw(20) << "Username"
-                 << setw(12) << "Komik ID"
-                 << setw(35) << "Komik Title" << endl;
-            cout << string(67, '-') << endl;
+            // Map id -> title sekali saja (bukan traversal per favorite)
+            unordered_map<int, string> titles;
+            tree.inOrder([&titles](Komik *k)
+                         { titles[k->id] = k->title; });
+
+            TableRenderer table;
+            table.setColumns({20, 12, 35});
+            table.headerRow({"Username", "Komik ID", "Komik Title"});
+            table.separator(67);
 
             for (const User &user : users)
             {
@@ -198,19 +324,13 @@ void databaseInspectorMenu(Database &db, BST &tree)
                     hasAnyFavorites = true;
                     for (int komikId : favs)
                     {
-                        string title = "Unknown";
-                        tree.inOrder([&title, komikId](Komik *k)
-                                     {
-                            if (k->id == komikId) {
-                                title = k->title;
-                            } });
-
-                        cout << left << setw(20) << user.username
-                             << setw(12) << komikId
-                             << setw(35) << title << endl;
+                        auto it = titles.find(komikId);
+                        table.cell(user.username).cell(komikId).cell(it != titles.end() ? it->second : "Unknown");
+                        table.endRow();
                     }
                 }
             }
+            table.flush();
 
             if (!hasAnyFavorites)
             {
@@ -280,28 +400,257 @@ void databaseInspectorMenu(Database &db, BST &tree)
         {
             printHeader("RUN CUSTOM SQL QUERY");
 
-            cout << "\033[33mWarning: Advanced feature!\033[0m\n";
-            cout << "Only SELECT queries are safe.\n";
+            const long MAX_ROWS = 200;
+            const int TIME_LIMIT_MS = 5000;
+
+            cout << "\033[33mRead-only connection: INSERT/UPDATE/DELETE are rejected.\033[0m\n";
+            cout << "Row limit: " << MAX_ROWS << " | Time limit: " << TIME_LIMIT_MS << " ms\n";
             cout << "Example: SELECT * FROM komiks WHERE genre LIKE '%Action%'\n\n";
 
             string query;
             cout << "Enter SQL query: ";
             getline(cin, query);
 
-            // Simple validation (hanya allow SELECT)
-            string queryLower = query;
-            transform(queryLower.begin(), queryLower.end(), queryLower.begin(), ::tolower);
+            db.flushWrites(); // koneksi read-only harus melihat mutation yang masih antre
+            QueryRunner runner;
+            runner.setTimeLimit(TIME_LIMIT_MS);
+            if (!runner.open(db.getPath()))
+            {
+                cout << "\033[31mError: Cannot open read-only connection!\033[0m" << endl;
+                pause();
+                break;
+            }
+
+            TableRenderer table;
+            QueryStats stats;
+            int columnCount = 0;
+
+            bool ok = runner.run(
+                query, MAX_ROWS,
+                [&](const vector<string> &columns)
+                {
+                    // Lebar kolom dari nama kolom (row di-stream, jadi tidak bisa ukur isi dulu)
+                    vector<int> widths;
+                    int totalWidth = 0;
+                    for (const string &name : columns)
+                    {
+                        int width = max(12, min(28, (int)name.size() + 2));
+                        widths.push_back(width);
+                        totalWidth += width;
+                    }
+                    columnCount = columns.size();
+                    table.setColumns(widths);
+                    cout << '\n';
+                    table.headerRow(columns);
+                    table.separator(max(totalWidth, 20));
+                    table.flush();
+                },
+                [&](sqlite3_stmt *stmt)
+                {
+                    for (int i = 0; i < columnCount; i++)
+                    {
+                        int type = sqlite3_column_type(stmt, i);
+                        if (type == SQLITE_NULL)
+                        {
+                            table.cell("NULL", 4);
+                        }
+                        else if (type == SQLITE_BLOB)
+                        {
+                            table.cell("<blob " + to_string(sqlite3_column_bytes(stmt, i)) + " bytes>");
+                        }
+                        else
+                        {
+                            const char *text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, i));
+                            size_t length = sqlite3_column_bytes(stmt, i);
+                            table.cell(text, min(length, (size_t)27)); // potong supaya kolom tetap rata
+                        }
+                    }
+                    table.endRow();
+                },
+                stats);
+            table.flush();
+
+            if (ok)
+            {
+                char timing[96];
+                snprintf(timing, sizeof(timing), " | prepare %.2f ms | step %.2f ms", stats.prepareMs, stats.stepMs);
+                cout << "\n\033[32m" << stats.rows << " row(s)\033[0m" << timing << endl;
+
+                if (stats.truncated)
+                    cout << "\033[33mOutput truncated at " << MAX_ROWS << " rows.\033[0m" << endl;
+                if (stats.timedOut)
+                    cout << "\033[33mQuery interrupted after " << TIME_LIMIT_MS << " ms.\033[0m" << endl;
+            }
+            else
+            {
+                cout << "\033[31mQuery rejected or failed!\033[0m" << endl;
+            }
+
+            pause();
+            break;
+        }
+
+        case 8:
+        {
+            printHeader("EXPORT TABLE");
+
+            string table, formatName, path;
+            cout << "Table (komiks/users/favorites): ";
+            getline(cin, table);
+            cout << "Format (csv/jsonl): ";
+            getline(cin, formatName);
+            cout << "Output file: ";
+            getline(cin, path);
+
+            ExportFormat format;
+            if (!Exporter::parseFormat(formatName, format))
+            {
+                cout << "\033[31mError: Unknown format '" << formatName << "'!\033[0m" << endl;
+                pause();
+                break;
+            }
+
+            Exporter exporter(db);
+            long rows = 0;
+            if (exporter.exportTable(table, format, path, rows))
+            {
+                cout << "\n\033[32mExported " << rows << " row(s) to " << path << "\033[0m" << endl;
+            }
+            else
+            {
+                cout << "\n\033[31mExport failed!\033[0m" << endl;
+            }
+
+            pause();
+            break;
+        }
+
+        case 9:
+        {
+            printHeader("PERFORMANCE METRICS");
+
+            if (!Metrics::enabled())
+            {
+                cout << "\033[33mMetrics compiled out (KOMIK_NO_METRICS).\033[0m" << endl;
+                pause();
+                break;
+            }
+
+            // Latency dari histogram (estimasi), total/avg/max exact
+            vector<MetricSnapshot> metrics = Metrics::instance().snapshot();
+            TableRenderer table;
+            table.setColumns({28, 10, 11, 10, 10, 10, 10, 10});
+            table.headerRow({"Operation", "Count", "Total ms", "Avg us", "p50 us", "p95 us", "p99 us", "Max us"});
+            table.separator(99);
+
+            char buffer[32];
+            for (const MetricSnapshot &m : metrics)
+            {
+                table.cell(m.name).cell((long long)m.count);
+                if (!m.timed)
+                {
+                    table.cell("-").cell("-").cell("-").cell("-").cell("-").cell("-");
+                    table.endRow();
+                    continue;
+                }
+
+                double values[] = {m.totalNs / 1e6, m.totalNs / 1e3 / m.count, m.p50Ns / 1e3,
+                                   m.p95Ns / 1e3, m.p99Ns / 1e3, m.maxNs / 1e3};
+                for (double value : values)
+                {
+                    snprintf(buffer, sizeof(buffer), "%.1f", value);
+                    table.cell(buffer);
+                }
+                table.endRow();
+            }
+
+            if (metrics.empty())
+                table.text("\033[33mBelum ada operasi yang tercatat.\033[0m\n");
+            table.flush();
+
+            cout << "\nReset metrics? (y/N): ";
+            string answer;
+            getline(cin, answer);
+            if (answer == "y" || answer == "Y")
+            {
+                Metrics::instance().reset();
+                cout << "\033[32mMetrics di-reset.\033[0m" << endl;
+            }
+
+            pause();
+            break;
+        }
 
-            if (queryLower.find("select") != 0)
+        case 10:
+        {
+            printHeader("TREE SHAPE DIAGNOSTICS");
+
+            TreeShape shape = tree.shape();
+            if (shape.nodes == 0)
             {
-                cout << "\033[31mError: Only SELECT queries are allowed!\033[0m" << endl;
+                cout << "\033[33mTree is empty!\033[0m" << endl;
                 pause();
                 break;
             }
 
-            // Execute query (perlu tambah function di Database.cpp)
-            cout << "\n\033[33mNote: Custom query execution not yet implemented.\033[0m" << endl;
-            cout << "Use DB Browser for SQLite or sqlite3 CLI for custom queries." << endl;
+            char buffer[64];
+            TableRenderer table;
+            table.setColumns({28, 30});
+            table.cell("Nodes:").cell((long long)shape.nodes).endRow();
+            snprintf(buffer, sizeof(buffer), "%d (optimal %d, %.2fx)", shape.height, shape.optimalHeight,
+                     (double)shape.height / shape.optimalHeight);
+            table.cell("Height:").cell(buffer).endRow();
+            snprintf(buffer, sizeof(buffer), "%.2f", shape.averageDepth);
+            table.cell("Average depth:").cell(buffer).endRow();
+            table.cell("Max depth:").cell((long long)shape.maxDepth).endRow();
+            table.cell("Unbalanced nodes (|bf|>1):").cell((long long)shape.unbalancedNodes).endRow();
+            table.cell("Max imbalance:").cell((long long)shape.maxImbalance).endRow();
+            if (shape.maxImbalance > 0)
+                table.cell("  at:").cell(shape.maxImbalanceTitle).endRow();
+
+            // Histogram depth; tree yang dalam digabung per rentang supaya tetap <= 40 baris
+            table.text("\nDepth histogram:\n");
+            size_t levels = shape.depthHistogram.size();
+            size_t step = (levels + 39) / 40;
+            int widest = 0;
+            vector<pair<string, int>> rows;
+            for (size_t start = 0; start < levels; start += step)
+            {
+                size_t end = min(levels, start + step);
+                int total = 0;
+                for (size_t d = start; d < end; d++)
+                    total += shape.depthHistogram[d];
+
+                if (step == 1)
+                    snprintf(buffer, sizeof(buffer), "%zu", start);
+                else
+                    snprintf(buffer, sizeof(buffer), "%zu-%zu", start, end - 1);
+                rows.push_back(make_pair(string(buffer), total));
+                widest = max(widest, total);
+            }
+
+            table.setColumns({12, 10});
+            for (const pair<string, int> &row : rows)
+            {
+                table.cell(row.first).cell((long long)row.second);
+                table.text(string(widest ? (row.second * 50 + widest - 1) / widest : 0, '#'));
+                table.endRow();
+            }
+            table.flush();
+
+            pause();
+            break;
+        }
+
+        case 11:
+        {
+            printHeader("MEMORY REPORT");
+
+            MemoryReport report;
+            tree.accountMemory(report);
+            manager.accountMemory(report);
+            auth.accountMemory(report);
+            report.print();
 
             pause();
             break;
@@ -318,8 +667,93 @@ void databaseInspectorMenu(Database &db, BST &tree)
 }
 
 // ===== MAIN FUNCTION =====
-int main()
+int main(int argc, char *argv[])
 {
+    // Opsi global: --slow-ms N (boleh di posisi mana saja)
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (string(argv[i]) == "--slow-ms")
+            slowQueryMs = atof(argv[i + 1]);
+    }
+
+    // Mode kiosk: search read-only langsung dari file katalog (tanpa database)
+    if (argc >= 3 && string(argv[1]) == "--catalog")
+    {
+        return runKioskMode(argv[2]);
+    }
+
+    // Mode batch: --batch <file | -> [--group N]
+    if (argc >= 3 && string(argv[1]) == "--batch")
+    {
+        int groupSize = 500;
+        if (argc >= 5 && string(argv[3]) == "--group")
+        {
+            groupSize = atoi(argv[4]);
+        }
+        return runBatchMode(argv[2], groupSize);
+    }
+
+    // Mode import: --import <file.csv | file.jsonl> [--strict] [--threads N]
+    if (argc >= 3 && string(argv[1]) == "--import")
+    {
+        bool strict = false;
+        int threads = 0;
+        for (int i = 3; i < argc; i++)
+        {
+            string arg = argv[i];
+            if (arg == "--strict")
+                strict = true;
+            else if (arg == "--threads" && i + 1 < argc)
+                threads = atoi(argv[++i]);
+        }
+        return runImportMode(argv[2], threads, strict);
+    }
+
+    // Mode export: --export <komiks|users|favorites> <csv|jsonl> <output file>
+    if (argc >= 5 && string(argv[1]) == "--export")
+    {
+        return runExportMode(argv[2], argv[3], argv[4]);
+    }
+
+    // Mode server: --server <unix socket path> [--threads N]
+    if (argc >= 3 && string(argv[1]) == "--server")
+    {
+        int threads = 8;
+        if (argc >= 5 && string(argv[3]) == "--threads")
+        {
+            threads = atoi(argv[4]);
+        }
+        return runServerMode(argv[2], threads);
+    }
+
+    // Mode generate: --generate <out.db | out.csv> [--comics N] [--users M] [--favorites F] [--seed S] [--zipf X]
+    if (argc >= 3 && string(argv[1]) == "--generate")
+    {
+        GeneratorConfig config;
+        bool userDataRequested = false;
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            string arg = argv[i];
+            if (arg == "--comics")
+                config.comics = atol(argv[i + 1]);
+            else if (arg == "--users")
+            {
+                config.users = atoi(argv[i + 1]);
+                userDataRequested = true;
+            }
+            else if (arg == "--favorites")
+            {
+                config.favorites = atol(argv[i + 1]);
+                userDataRequested = true;
+            }
+            else if (arg == "--seed")
+                config.seed = (unsigned int)strtoul(argv[i + 1], nullptr, 10);
+            else if (arg == "--zipf")
+                config.zipfExponent = atof(argv[i + 1]);
+        }
+        return runGenerateMode(argv[2], config, userDataRequested);
+    }
+
     cout << "\033[1;36m";
     cout << "==============================================\n";
     cout << "   KOMIK MANAGEMENT SYSTEM\n";
@@ -337,14 +771,22 @@ int main()
         return 1;
     }
 
+    // Mutation di-commit background writer; durable ack: write baru return
+    // setelah commit, jadi kegagalan langsung sampai ke manager (state memory tidak diubah)
+    dbConnection.enableWriteBehind(5, true);
+    dbConnection.enableSlowQueryLog(SLOW_QUERY_LOG, slowQueryMs);
+
     // Initialize managers
     KomikManager manager(&dbConnection);
     BST tree;
     Auth auth(&dbConnection);
 
-    // Load data from database
-    cout << "Loading data from database...\n";
-    manager.loadDataFromDB(tree);
+    // Load data: coba snapshot dulu, kalau tidak valid baru dari database
+    cout << "Loading data...\n";
+    if (!Snapshot::load(SNAPSHOT_FILE, tree, dbConnection))
+    {
+        manager.loadDataFromDB(tree);
+    }
 
     cout << "\033[32mSystem initialized successfully!\033[0m\n"
          << endl;
@@ -354,6 +796,9 @@ int main()
     MenuSystem menuSystem(tree, manager, auth);
     menuSystem.showMainMenu();
 
+    // Simpan snapshot untuk startup berikutnya
+    Snapshot::save(SNAPSHOT_FILE, tree, dbConnection);
+
     // Close database connection
     dbConnection.close();
 
@@ -648,30 +1093,7 @@ void crudKomikMenu(BST &tree, KomikManager &manager)
 
         case 2:
         {
-            printHeader("ALL COMICS (IN-ORDER TRAVERSAL)");
-
-            if (tree.isEmpty())
-            {
-                cout << "\033[33mNo comics found!\033[0m" << endl;
-            }
-            else
-            {
-                cout << left << setw(5) << "ID"
-                     << setw(30) << "Title"
-                     << setw(25) << "Author"
-                     << setw(20) << "Genre(s)" << endl;
-                cout << string(80, '-') << endl;
-
-                tree.inOrder([](Komik *comic)
-                             { cout << left << setw(5) << comic->id
-                                    << setw(30) << comic->title
-                                    << setw(25) << comic->author
-                                    << setw(20) << comic->genre << endl; });
-
-                cout << "\nTotal: " << tree.count() << " comics" << endl;
-            }
-
-            pause();
+            browseKomikPages(tree, "ALL COMICS (IN-ORDER TRAVERSAL)");
             break;
         }
 
@@ -691,22 +1113,17 @@ void crudKomikMenu(BST &tree, KomikManager &manager)
             }
             else
             {
-                cout << "\033[32m\nFound " << results.size() << " comic(s):\033[0m\n"
-                     << endl;
-
-                cout << left << setw(5) << "ID"
-                     << setw(30) << "Title"
-                     << setw(25) << "Author"
-                     << setw(20) << "Genre(s)" << endl;
-                cout << string(80, '-') << endl;
+                TableRenderer table;
+                table.text("\033[32m\nFound ");
+                table.number(results.size());
+                table.text(" comic(s):\033[0m\n\n");
 
+                table.komikHeader();
                 for (Komik *comic : results)
                 {
-                    cout << left << setw(5) << comic->id
-                         << setw(30) << comic->title
-                         << setw(25) << comic->author
-                         << setw(20) << comic->genre << endl;
+                    table.komikRow(comic);
                 }
+                table.flush();
             }
 
             pause();
@@ -798,6 +1215,7 @@ void crudKomikMenu(BST &tree, KomikManager &manager)
 
             if (confirm == 'y' || confirm == 'Y')
             {
+                manager.forgetKomik(found->id);
                 tree.remove(found->title); // Pakai title dari found
                 cout << "\033[32mKomik deleted successfully!\033[0m" << endl;
             }
@@ -1025,8 +1443,10 @@ void traversalMenu(BST &tree)
             }
             else
             {
-                tree.preOrder([](Komik *comic)
-                              { comic->display(); });
+                TableRenderer table;
+                tree.preOrder([&table](Komik *comic)
+                              { table.komikLine(comic); });
+                table.flush();
             }
             pause();
             break;
@@ -1041,8 +1461,10 @@ void traversalMenu(BST &tree)
             }
             else
             {
-                tree.inOrder([](Komik *comic)
-                             { comic->display(); });
+                TableRenderer table;
+                tree.inOrder([&table](Komik *comic)
+                             { table.komikLine(comic); });
+                table.flush();
             }
             pause();
             break;
@@ -1057,8 +1479,10 @@ void traversalMenu(BST &tree)
             }
             else
             {
-                tree.postOrder([](Komik *comic)
-                               { comic->display(); });
+                TableRenderer table;
+                tree.postOrder([&table](Komik *comic)
+                               { table.komikLine(comic); });
+                table.flush();
             }
             pause();
             break;
@@ -1066,6 +1490,63 @@ void traversalMenu(BST &tree)
     } while (choice != 0);
 }
 
+// ===== BROWSE KOMIK (PAGINATED) =====
+// Tampilkan komik per halaman (urut title), satu kali flush per layar
+void browseKomikPages(BST &tree, const string &title)
+{
+    const size_t PAGE_SIZE = 20;
+
+    if (tree.isEmpty())
+    {
+        printHeader(title);
+        cout << "\033[33mNo comics found!\033[0m" << endl;
+        pause();
+        return;
+    }
+
+    // Cursor ke tree: hanya simpan key awal tiap halaman, bukan seluruh katalog
+    size_t total = tree.count();
+    size_t totalPages = (total + PAGE_SIZE - 1) / PAGE_SIZE;
+    vector<Komik> pageStarts; // key terakhir sebelum halaman ke-i (i >= 1)
+    size_t page = 0;
+    TableRenderer table;
+
+    while (true)
+    {
+        const Komik *after = page == 0 ? nullptr : &pageStarts[page - 1];
+        // Ambil satu ekstra untuk tahu masih ada halaman berikutnya
+        vector<Komik *> komiks = tree.collectAfter(after, PAGE_SIZE + 1);
+        bool hasNext = komiks.size() > PAGE_SIZE;
+        if (hasNext)
+            komiks.pop_back();
+
+        printHeader(title);
+        table.komikHeader();
+        for (Komik *k : komiks)
+        {
+            table.komikRow(k);
+        }
+
+        PageCommand command = readPageCommand(table, page, totalPages, total, hasNext);
+        if (command == PAGE_QUIT)
+            break;
+
+        if (command == PAGE_PREV)
+        {
+            page--;
+        }
+        else if (command == PAGE_NEXT)
+        {
+            if (pageStarts.size() == page)
+            {
+                const Komik *last = komiks.back();
+                pageStarts.push_back(Komik(last->id, last->title, last->author, last->genre));
+            }
+            page++;
+        }
+    }
+}
+
 // ===== VIEW FAVORITES MENU =====
 void viewFavoritesMenu(KomikManager &manager, BST &tree)
 {
@@ -1082,10 +1563,14 @@ void viewFavoritesMenu(KomikManager &manager, BST &tree)
     {
         bool hasAnyFavorites = false;
 
-        cout << left << setw(15) << "Username"
-             << setw(10) << "Komik ID"
-             << setw(30) << "Komik Title" << endl;
-        cout << string(55, '-') << endl;
+        unordered_map<int, string> titles;
+        tree.inOrder([&titles](Komik *comic)
+                     { titles[comic->id] = comic->title; });
+
+        TableRenderer table;
+        table.setColumns({15, 10, 30});
+        table.headerRow({"Username", "Komik ID", "Komik Title"});
+        table.separator(55);
 
         for (const User &user : allUsers)
         {
@@ -1096,20 +1581,13 @@ void viewFavoritesMenu(KomikManager &manager, BST &tree)
                 hasAnyFavorites = true;
                 for (int comicId : favorites)
                 {
-                    string comicTitle = "Unknown";
-
-                    tree.inOrder([&comicTitle, comicId](Komik *comic)
-                                 {
-                        if (comic->id == comicId) {
-                            comicTitle = comic->title;
-                        } });
-
-                    cout << left << setw(15) << user.username
-                         << setw(10) << comicId
-                         << setw(30) << comicTitle << endl;
+                    auto it = titles.find(comicId);
+                    table.cell(user.username).cell(comicId).cell(it != titles.end() ? it->second : "Unknown");
+                    table.endRow();
                 }
             }
         }
+        table.flush();
 
         if (!hasAnyFavorites)
         {
@@ -1118,4 +1596,307 @@ void viewFavoritesMenu(KomikManager &manager, BST &tree)
     }
 
     pause();
-}
\ No newline at end of file
+}
+
+// ===== KIOSK MODE (READ-ONLY CATALOG) =====
+int runKioskMode(const string &catalogPath)
+{
+    CatalogImage catalog;
+    if (!catalog.open(catalogPath))
+    {
+        cout << "\033[31mFailed to open catalog!\033[0m\n";
+        return 1;
+    }
+
+    // Checksum seluruh file sebelum dipakai (file bisa rusak / bukan hasil Snapshot::save)
+    if (!catalog.verify())
+    {
+        cout << "\033[31mCatalog checksum mismatch, file is corrupt!\033[0m\n";
+        return 1;
+    }
+
+    SearchFilter filter;
+    int choice;
+
+    do
+    {
+        printHeader("KOMIK CATALOG (READ-ONLY)");
+
+        cout << "Catalog: " << catalogPath << " (" << catalog.size() << " comics)\n\n";
+        cout << "1. Search by Title\n";
+        cout << "2. Search by Author\n";
+        cout << "3. Filter by Genre (e.g. 'Action, Horror')\n";
+        cout << "4. Find Exact Title\n";
+        cout << "0. Exit\n";
+        cout << "\nChoice: ";
+
+        cin >> choice;
+
+        if (cin.fail())
+        {
+            if (cin.eof())
+                break;
+            cin.clear();
+            choice = -1;
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+        if (choice < 1 || choice > 4)
+        {
+            if (choice != 0)
+            {
+                cout << "\033[31mInvalid choice!\033[0m" << endl;
+                pause();
+            }
+            continue;
+        }
+
+        string keyword;
+        cout << "Enter keyword: ";
+        getline(cin, keyword);
+
+        vector<size_t> results;
+        if (choice == 4)
+        {
+            // Record urut by title: binary search, tanpa scan
+            long index = catalog.findByTitle(keyword);
+            if (index >= 0)
+                results.push_back((size_t)index);
+        }
+        else if (choice == 1)
+            results = filter.searchByTitle(catalog, keyword);
+        else if (choice == 2)
+            results = filter.searchByAuthor(catalog, keyword);
+        else
+            results = filter.searchByGenre(catalog, keyword);
+
+        filter.displayResults(catalog, results, "Search: " + keyword);
+        pause();
+    } while (choice != 0);
+
+    return 0;
+}
+
+// ===== BATCH MODE (NON-INTERACTIVE) =====
+int runBatchMode(const string &batchPath, int groupSize)
+{
+    dbConnection.setVerbose(false);
+    if (!dbConnection.open("komik_database.db"))
+    {
+        cerr << "Failed to connect to database!" << endl;
+        return 1;
+    }
+
+    KomikManager manager(&dbConnection);
+    manager.setVerbose(false);
+    BST tree;
+
+    if (!Snapshot::load(SNAPSHOT_FILE, tree, dbConnection))
+    {
+        manager.loadDataFromDB(tree);
+    }
+
+    BatchRunner runner(tree, manager, dbConnection);
+    runner.setGroupSize(groupSize);
+
+    int failed;
+    if (batchPath == "-")
+    {
+        failed = runner.run(cin, cout);
+    }
+    else
+    {
+        ifstream file(batchPath.c_str());
+        if (!file)
+        {
+            cerr << "Cannot open batch file: " << batchPath << endl;
+            dbConnection.close();
+            return 1;
+        }
+        failed = runner.run(file, cout);
+    }
+
+    Snapshot::save(SNAPSHOT_FILE, tree, dbConnection);
+    dbConnection.close();
+
+    return failed == 0 ? 0 : 2;
+}
+
+// ===== IMPORT MODE (CSV / JSONL) =====
+int runImportMode(const string &importPath, int threads, bool strict)
+{
+    dbConnection.setVerbose(false);
+    if (!dbConnection.open("komik_database.db"))
+    {
+        cerr << "Failed to connect to database!" << endl;
+        return 1;
+    }
+
+    KomikManager manager(&dbConnection);
+    manager.setVerbose(false);
+    BST tree;
+
+    if (!Snapshot::load(SNAPSHOT_FILE, tree, dbConnection))
+    {
+        manager.loadDataFromDB(tree);
+    }
+
+    Importer importer(tree, manager, dbConnection);
+    importer.setStrict(strict);
+    if (threads > 0)
+    {
+        importer.setThreads(threads);
+    }
+
+    ImportReport report;
+    bool ok = importer.importFile(importPath, report);
+
+    if (ok)
+    {
+        for (const string &error : report.errors)
+        {
+            cerr << "Rejected " << error << '\n';
+        }
+
+        cout << "Rows read:   " << report.rowsRead << '\n'
+             << "Imported:    " << report.imported << '\n'
+             << "Duplicates:  " << report.duplicates << '\n'
+             << "Rejected:    " << report.rejected << '\n'
+             << "New authors: " << report.newAuthors << '\n'
+             << "New genres:  " << report.newGenres << '\n'
+             << "Parse: " << report.parseMs << " ms | Insert: " << report.insertMs
+             << " ms | Build tree: " << report.buildMs << " ms" << endl;
+
+        Snapshot::save(SNAPSHOT_FILE, tree, dbConnection);
+    }
+
+    dbConnection.close();
+    return ok ? 0 : 1;
+}
+
+// ===== EXPORT MODE =====
+int runExportMode(const string &table, const string &formatName, const string &outPath)
+{
+    ExportFormat format;
+    if (!Exporter::parseFormat(formatName, format))
+    {
+        cerr << "Unknown format: " << formatName << " (use csv or jsonl)" << endl;
+        return 1;
+    }
+
+    dbConnection.setVerbose(false);
+    if (!dbConnection.open("komik_database.db"))
+    {
+        cerr << "Failed to connect to database!" << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    Exporter exporter(dbConnection);
+    long rows = 0;
+    bool ok = exporter.exportTable(table, format, outPath, rows);
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (ok)
+    {
+        cout << "Exported " << rows << " row(s) from " << table << " to " << outPath
+             << " in " << ms << " ms" << endl;
+    }
+
+    dbConnection.close();
+    return ok ? 0 : 1;
+}
+
+// Server yang sedang jalan, dihentikan oleh Ctrl+C / SIGTERM
+CatalogServer *activeServer = nullptr;
+
+void handleStopSignal(int)
+{
+    if (activeServer != nullptr)
+        activeServer->stop();
+}
+
+int runServerMode(const string &socketPath, int threads)
+{
+    dbConnection.setVerbose(false);
+    if (!dbConnection.open("komik_database.db"))
+    {
+        cerr << "Failed to connect to database!" << endl;
+        return 1;
+    }
+
+    // Durable ack: reply OK ke client hanya setelah mutation ter-commit;
+    // write dari banyak koneksi tetap digabung dalam satu transaction
+    dbConnection.enableWriteBehind(5, true);
+    dbConnection.enableSlowQueryLog(SLOW_QUERY_LOG, slowQueryMs);
+
+    KomikManager manager(&dbConnection);
+    manager.setVerbose(false);
+    BST tree;
+    Auth auth(&dbConnection);
+
+    if (!Snapshot::load(SNAPSHOT_FILE, tree, dbConnection))
+    {
+        manager.loadDataFromDB(tree);
+    }
+
+    CatalogServer server(tree, manager, dbConnection, auth);
+    server.setThreadCount(threads);
+
+    activeServer = &server;
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN); // client putus di tengah response
+#endif
+
+    int status = server.run(socketPath);
+    activeServer = nullptr;
+
+    Snapshot::save(SNAPSHOT_FILE, tree, dbConnection);
+    dbConnection.close();
+    return status;
+}
+
+int runGenerateMode(const string &outPath, const GeneratorConfig &config, bool userDataRequested)
+{
+    CatalogGenerator generator(config);
+    GeneratorReport report;
+
+    bool isCsv = outPath.size() >= 4 && outPath.compare(outPath.size() - 4, 4, ".csv") == 0;
+    if (isCsv)
+    {
+        // CSV hanya berisi komiks (format --import), users/favorites tidak punya tempat
+        if (userDataRequested)
+        {
+            cerr << "--users / --favorites are not supported for CSV output (comics only): " << outPath << endl;
+            return 1;
+        }
+
+        if (!generator.writeCsv(outPath, report))
+            return 1;
+    }
+    else
+    {
+        // Database terpisah (bukan dbConnection) supaya bisa generate ke file lain
+        Database target;
+        target.setVerbose(false);
+        if (!target.open(outPath))
+        {
+            cerr << "Failed to open database: " << outPath << endl;
+            return 1;
+        }
+
+        bool ok = generator.writeDatabase(target, report);
+        target.close();
+        if (!ok)
+            return 1;
+    }
+
+    cout << "Generated " << report.comics << " comics (" << report.authors << " authors)";
+    if (!isCsv)
+        cout << ", " << report.users << " users, " << report.favorites << " favorites";
+    cout << " to " << outPath << " in " << report.ms << " ms (seed " << config.seed << ")" << endl;
+    return 0;
+}
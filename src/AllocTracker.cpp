@@ -0,0 +1,130 @@
+/*
+ * AllocTracker.cpp
+ * Hook operator new/delete (opt-in, -DKOMIK_TRACK_ALLOC) + scope penghitung alokasi
+ */
+
+#include "../include/AllocTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace std;
+
+// Atomic dengan konstruktor constexpr: sudah nol sebelum alokasi pertama
+static atomic<unsigned long long> allocationCount(0);
+static atomic<unsigned long long> freeCount(0);
+static atomic<unsigned long long> allocatedBytes(0);
+
+// ===== TRACKER =====
+bool AllocTracker::tracking()
+{
+#ifdef KOMIK_TRACK_ALLOC
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocStats AllocTracker::current()
+{
+    AllocStats stats;
+    stats.allocations = allocationCount.load(memory_order_relaxed);
+    stats.frees = freeCount.load(memory_order_relaxed);
+    stats.bytes = allocatedBytes.load(memory_order_relaxed);
+    return stats;
+}
+
+void AllocTracker::recordAlloc(size_t bytes)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(bytes, memory_order_relaxed);
+}
+
+void AllocTracker::recordFree()
+{
+    freeCount.fetch_add(1, memory_order_relaxed);
+}
+
+// ===== SCOPE =====
+AllocScope::AllocScope() : start(AllocTracker::current())
+{
+}
+
+AllocStats AllocScope::delta() const
+{
+    AllocStats now = AllocTracker::current();
+    AllocStats result;
+    result.allocations = now.allocations - start.allocations;
+    result.frees = now.frees - start.frees;
+    result.bytes = now.bytes - start.bytes;
+    return result;
+}
+
+bool AllocScope::withinBudget(const string &name, unsigned long long maxAllocations) const
+{
+    unsigned long long used = allocations();
+    if (used <= maxAllocations)
+        return true;
+
+    cerr << "Alloc budget exceeded: " << name << " used " << used << " allocations (budget " << maxAllocations
+         << ")" << endl;
+    return false;
+}
+
+// ===== GLOBAL HOOK =====
+// Menggantikan operator new/delete bawaan untuk seluruh program. Varian array,
+// sized, dan nothrow bawaan libstdc++ semuanya diteruskan ke sini.
+#ifdef KOMIK_TRACK_ALLOC
+
+void *operator new(size_t size)
+{
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw bad_alloc();
+    AllocTracker::recordAlloc(size);
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+    void *p = malloc(size ? size : 1);
+    if (p)
+        AllocTracker::recordAlloc(size);
+    return p;
+}
+
+void *operator new[](size_t size, const nothrow_t &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept
+{
+    if (!p)
+        return;
+    AllocTracker::recordFree();
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+#endif
@@ -5,6 +5,8 @@
 
 #include "../include/Auth.h"
 #include "../include/Database.h"
+#include "../include/Metrics.h"
+#include "../include/MemoryReport.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
@@ -252,6 +254,8 @@ bool Auth::registerWithMaskedPassword(const string &username, const string &role
 // ===== LOGIN =====
 bool Auth::login(const string &username, const string &password)
 {
+    METRIC_TIMER("auth.login");
+
     if (username.empty() || password.empty())
     {
         cerr << "Username and password cannot be empty!" << endl;
@@ -260,6 +264,7 @@ bool Auth::login(const string &username, const string &password)
 
     if (!usernameExists(username))
     {
+        METRIC_COUNT("auth.login.failed");
         cerr << "Username not found!" << endl;
         return false;
     }
@@ -268,6 +273,7 @@ bool Auth::login(const string &username, const string &password)
 
     if (!verifyPassword(password, user.password))
     {
+        METRIC_COUNT("auth.login.failed");
         cerr << "Wrong password!" << endl;
         return false;
     }
@@ -284,6 +290,19 @@ bool Auth::login(const string &username, const string &password)
     return true;
 }
 
+// ===== AUTHENTICATE (tanpa session) =====
+bool Auth::authenticate(const string &username, const string &password, User &result)
+{
+    METRIC_TIMER("auth.authenticate");
+
+    map<string, User>::const_iterator it = users.find(username);
+    if (it == users.end() || !verifyPassword(password, it->second.password))
+        return false;
+
+    result = it->second;
+    return true;
+}
+
 // ===== LOGIN WITH MASKED PASSWORD =====
 bool Auth::loginWithMaskedPassword(const string &username)
 {
@@ -414,6 +433,20 @@ bool Auth::updateUserRole(const string &username, const string &newRole)
     return true;
 }
 
+// ===== MEMORY =====
+void Auth::accountMemory(MemoryReport &report) const
+{
+    size_t bytes = users.size() * MemoryReport::mapNodeBytes(users);
+    for (const auto &entry : users)
+    {
+        bytes += report.stringBytes(entry.first);
+        bytes += report.stringBytes(entry.second.username);
+        bytes += report.stringBytes(entry.second.password);
+        bytes += report.stringBytes(entry.second.role);
+    }
+    report.add("Auth users (map)", users.size(), bytes);
+}
+
 // ===== LOAD DEFAULT USERS =====
 void Auth::loadDefaultUsers()
 {
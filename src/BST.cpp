@@ -1,4 +1,8 @@
 #include "../include/BST.h"
+#include "../include/TableRenderer.h"
+#include "../include/Metrics.h"
+#include "../include/MemoryReport.h"
+#include "../include/TextMatch.h"
 #include <iostream>
 #include <vector>
 #include <functional>
@@ -9,6 +13,7 @@
 BST::BST()
 {
     root = nullptr;
+    nodeCount = 0;
 }
 
 BST::~BST()
@@ -36,6 +41,7 @@ void BST::destroyTree(Komik *node)
 
 void BST::insert(Komik *newKomik)
 {
+    METRIC_TIMER("bst.insert");
     root = insertHelper(root, newKomik);
 }
 
@@ -49,6 +55,7 @@ Komik *BST::insertHelper(Komik *node, Komik *newKomik)
     // BASE CASE: jika node kosong, berarti ini posisi yang tepat!
     if (node == nullptr)
     {
+        nodeCount++;
         return newKomik; // Return komik baru sebagai node di posisi ini
     }
 
@@ -86,6 +93,7 @@ Komik *BST::insertHelper(Komik *node, Komik *newKomik)
 
 Komik *BST::search(const string &title) const
 {
+    METRIC_TIMER("bst.search");
     return searchHelper(root, title);
 }
 
@@ -107,6 +115,26 @@ Komik *BST::searchHelper(Komik *node, const string &title) const
     }
 }
 
+// ===== FIND (EXACT KEY) =====
+// Cari node dengan title, author, dan genre yang sama persis
+Komik *BST::find(const Komik &key) const
+{
+    METRIC_TIMER("bst.find");
+    Komik *node = root;
+
+    while (node != nullptr)
+    {
+        if (key < *node)
+            node = node->left;
+        else if (key > *node)
+            node = node->right;
+        else
+            return node;
+    }
+
+    return nullptr;
+}
+
 // ===== NEW: TO LOWERCASE HELPER =====
 string BST::toLowerCase(const string &str) const
 {
@@ -121,36 +149,35 @@ string BST::toLowerCase(const string &str) const
 // ===== NEW: SEARCH PARTIAL (case-insensitive & partial match) =====
 vector<Komik *> BST::searchPartial(const string &keyword) const
 {
+    METRIC_TIMER("bst.searchPartial");
     vector<Komik *> results;
-    searchPartialHelper(root, keyword, results);
+    // Keyword di-lowercase sekali, bukan per node
+    searchPartialHelper(root, toLowerCase(keyword), results);
     return results;
 }
 
 // ===== NEW: SEARCH PARTIAL HELPER =====
-void BST::searchPartialHelper(Komik *node, const string &keyword, vector<Komik *> &results) const
+void BST::searchPartialHelper(Komik *node, const string &lowerKeyword, vector<Komik *> &results) const
 {
     if (node == nullptr)
         return;
 
-    // Convert title dan keyword ke lowercase untuk perbandingan
-    string lowerTitle = toLowerCase(node->title);
-    string lowerKeyword = toLowerCase(keyword);
-
-    // Cek apakah keyword ada di dalam title (partial match)
-    if (lowerTitle.find(lowerKeyword) != string::npos)
+    // Cek apakah keyword ada di dalam title (partial match, case-insensitive)
+    if (containsLowered(node->title, lowerKeyword))
     {
         results.push_back(node);
     }
 
     // Tetap search di left dan right (traverse semua node)
-    searchPartialHelper(node->left, keyword, results);
-    searchPartialHelper(node->right, keyword, results);
+    searchPartialHelper(node->left, lowerKeyword, results);
+    searchPartialHelper(node->right, lowerKeyword, results);
 }
 
 // ===== REMOVE (public interface) =====
 // Fungsi untuk hapus komik dari tree
 bool BST::remove(const string &title)
 {
+    METRIC_TIMER("bst.remove");
     // Cek dulu apakah komik ada
     if (search(title) == nullptr)
     {
@@ -193,6 +220,7 @@ Komik *BST::deleteHelper(Komik *node, const string &title)
         if (node->left == nullptr && node->right == nullptr)
         {
             delete node;
+            nodeCount--;
             return nullptr;
         }
 
@@ -201,6 +229,7 @@ Komik *BST::deleteHelper(Komik *node, const string &title)
         {
             Komik *temp = node->right;
             delete node;
+            nodeCount--;
             return temp;
         }
 
@@ -209,6 +238,7 @@ Komik *BST::deleteHelper(Komik *node, const string &title)
         {
             Komik *temp = node->left;
             delete node;
+            nodeCount--;
             return temp;
         }
 
@@ -254,6 +284,7 @@ Komik *BST::findMin(Komik *node) const
 // Update data komik
 bool BST::update(const string &oldTitle, Komik *updatedKomik)
 {
+    METRIC_TIMER("bst.update");
     // Cari komik yang mau diupdate
     Komik *comic = search(oldTitle);
 
@@ -293,13 +324,14 @@ bool BST::update(const string &oldTitle, Komik *updatedKomik)
 // Urutan: Root → Left → Right
 void BST::preOrder(function<void(Komik *)> callback) const
 {
+    METRIC_TIMER("bst.preOrder");
     // function<void(Komik*)> callback = fungsi yang dikirim sebagai parameter
     // Contoh: tree.preOrder([](Komik* k) { k->display(); });
 
     preOrderHelper(root, callback);
 }
 
-void BST::preOrderHelper(Komik *node, function<void(Komik *)> callback) const
+void BST::preOrderHelper(Komik *node, const function<void(Komik *)> &callback) const
 {
     if (node == nullptr)
     {
@@ -317,10 +349,11 @@ void BST::preOrderHelper(Komik *node, function<void(Komik *)> callback) const
 // PENTING: Hasil IN-ORDER = data TERURUT (sorted)!
 void BST::inOrder(function<void(Komik *)> callback) const
 {
+    METRIC_TIMER("bst.inOrder");
     inOrderHelper(root, callback);
 }
 
-void BST::inOrderHelper(Komik *node, function<void(Komik *)> callback) const
+void BST::inOrderHelper(Komik *node, const function<void(Komik *)> &callback) const
 {
     if (node == nullptr)
     {
@@ -337,10 +370,11 @@ void BST::inOrderHelper(Komik *node, function<void(Komik *)> callback) const
 // Urutan: Left → Right → Root
 void BST::postOrder(function<void(Komik *)> callback) const
 {
+    METRIC_TIMER("bst.postOrder");
     postOrderHelper(root, callback);
 }
 
-void BST::postOrderHelper(Komik *node, function<void(Komik *)> callback) const
+void BST::postOrderHelper(Komik *node, const function<void(Komik *)> &callback) const
 {
     if (node == nullptr)
     {
@@ -363,34 +397,143 @@ bool BST::isEmpty() const
 }
 
 // ===== COUNT =====
-// Hitung total node di tree
+// Total node di tree (counter dijaga setiap insert/delete/build, tanpa traversal)
 int BST::count() const
 {
-    return countHelper(root);
+    return nodeCount;
 }
 
-int BST::countHelper(Komik *node) const
+// ===== CLEAR =====
+// Hapus semua node di tree
+void BST::clear()
 {
-    if (node == nullptr)
+    destroyTree(root); // Hapus semua node
+    root = nullptr;    // Set root jadi null (tree kosong)
+    nodeCount = 0;
+}
+
+// ===== SHAPE DIAGNOSTICS =====
+// Post-order iteratif: depth dicatat saat node pertama dikunjungi, tinggi
+// subtree dihitung saat node selesai (tinggi anak diambil dari stack).
+TreeShape BST::shape() const
+{
+    METRIC_TIMER("bst.shape");
+    TreeShape result;
+    if (root == nullptr)
+        return result;
+
+    struct Frame
     {
-        return 0;
+        Komik *node;
+        int depth;
+        bool expanded;
+    };
+
+    vector<Frame> stack;
+    vector<int> heights; // tinggi subtree yang sudah selesai
+    long long depthSum = 0;
+
+    Frame first = {root, 0, false};
+    stack.push_back(first);
+
+    while (!stack.empty())
+    {
+        Frame &top = stack.back();
+        Komik *node = top.node;
+
+        if (!top.expanded)
+        {
+            top.expanded = true;
+            int depth = top.depth;
+
+            result.nodes++;
+            depthSum += depth;
+            if ((int)result.depthHistogram.size() <= depth)
+                result.depthHistogram.resize(depth + 1, 0);
+            result.depthHistogram[depth]++;
+
+            // Left di-push dulu: right selesai duluan, jadi tinggi left ada di atas stack
+            if (node->left)
+            {
+                Frame child = {node->left, depth + 1, false};
+                stack.push_back(child);
+            }
+            if (node->right)
+            {
+                Frame child = {node->right, depth + 1, false};
+                stack.push_back(child);
+            }
+            continue;
+        }
+
+        int leftHeight = 0, rightHeight = 0;
+        if (node->left)
+        {
+            leftHeight = heights.back();
+            heights.pop_back();
+        }
+        if (node->right)
+        {
+            rightHeight = heights.back();
+            heights.pop_back();
+        }
+        heights.push_back(1 + max(leftHeight, rightHeight));
+
+        int imbalance = leftHeight > rightHeight ? leftHeight - rightHeight : rightHeight - leftHeight;
+        if (imbalance > 1)
+            result.unbalancedNodes++;
+        if (imbalance > result.maxImbalance)
+        {
+            result.maxImbalance = imbalance;
+            result.maxImbalanceTitle = node->title;
+        }
+
+        stack.pop_back();
     }
 
-    // Rumus rekursif:
-    // Total = 1 (node ini) + jumlah di left + jumlah di right
-    return 1 + countHelper(node->left) + countHelper(node->right);
+    result.height = heights.back();
+    result.maxDepth = result.height - 1;
+    result.averageDepth = (double)depthSum / result.nodes;
+    for (long long capacity = 1; capacity <= result.nodes; capacity *= 2)
+        result.optimalHeight++;
+    return result;
 }
 
-// ===== CLEAR =====
-// Hapus semua node di tree
-void BST::clear()
+// ===== MEMORY =====
+void BST::accountMemory(MemoryReport &report) const
 {
-    destroyTree(root); // Hapus semua node
-    root = nullptr;    // Set root jadi null (tree kosong)
+    size_t nodes = 0, heapStrings = 0, stringBytes = 0;
+    vector<Komik *> stack;
+    if (root)
+        stack.push_back(root);
+
+    while (!stack.empty())
+    {
+        Komik *node = stack.back();
+        stack.pop_back();
+        nodes++;
+
+        const string *fields[] = {&node->title, &node->author, &node->genre};
+        for (const string *field : fields)
+        {
+            size_t bytes = report.stringBytes(*field);
+            heapStrings += bytes > 0;
+            stringBytes += bytes;
+        }
+
+        if (node->left)
+            stack.push_back(node->left);
+        if (node->right)
+            stack.push_back(node->right);
+    }
+
+    report.add("BST nodes (Komik)", nodes, nodes * MemoryReport::heapBlock(sizeof(Komik)));
+    report.add("Komik strings (heap)", heapStrings, stringBytes);
 }
 
 vector<Komik *> BST::getAllKomiks() const
 {
+    METRIC_TIMER("bst.getAllKomiks");
     vector<Komik *> comics;
 
     inOrder([&comics](Komik *comic)
@@ -399,6 +542,133 @@ vector<Komik *> BST::getAllKomiks() const
     return comics; // Return vector berisi semua komik
 }
 
+// ===== BUILD BALANCED =====
+// Ganti isi tree dengan komik yang sudah terurut (misal dari snapshot)
+// Ambil elemen tengah sebagai root supaya tinggi tree ~log2(n)
+void BST::buildBalanced(const vector<Komik *> &sortedKomiks)
+{
+    METRIC_TIMER("bst.buildBalanced");
+    clear();
+    root = buildBalancedHelper(sortedKomiks, 0, (int)sortedKomiks.size() - 1);
+    nodeCount = (int)sortedKomiks.size();
+}
+
+Komik *BST::buildBalancedHelper(const vector<Komik *> &komiks, int low, int high)
+{
+    if (low > high)
+    {
+        return nullptr;
+    }
+
+    int mid = low + (high - low) / 2;
+    Komik *node = komiks[mid];
+
+    node->left = buildBalancedHelper(komiks, low, mid - 1);
+    node->right = buildBalancedHelper(komiks, mid + 1, high);
+
+    return node;
+}
+
+// ===== BULK INSERT =====
+// Dipakai importer: daripada insert satu per satu (bisa O(n^2) kalau data urut),
+// node lama + node baru di-merge secara terurut lalu tree dibangun ulang
+void BST::bulkInsert(vector<Komik *> newKomiks)
+{
+    METRIC_TIMER("bst.bulkInsert");
+    stable_sort(newKomiks.begin(), newKomiks.end(), [](Komik *a, Komik *b)
+         { return *a < *b; });
+
+    vector<Komik *> existing;
+    collectNodes(root, existing);
+
+    vector<Komik *> merged;
+    merged.reserve(existing.size() + newKomiks.size());
+
+    size_t i = 0, j = 0;
+    while (i < existing.size() || j < newKomiks.size())
+    {
+        Komik *candidate;
+        // Kalau key sama, ambil node lama duluan supaya node lama yang dipertahankan
+        if (j == newKomiks.size() || (i < existing.size() && !(*newKomiks[j] < *existing[i])))
+            candidate = existing[i++];
+        else
+            candidate = newKomiks[j++];
+
+        // Duplikat (title, author, genre sama): sama seperti insert, update data lama
+        if (!merged.empty() && *merged.back() == *candidate)
+        {
+            merged.back()->id = candidate->id;
+            delete candidate;
+            continue;
+        }
+
+        merged.push_back(candidate);
+    }
+
+    // Node dipakai ulang, jadi root cukup dilepas (jangan destroyTree)
+    root = buildBalancedHelper(merged, 0, (int)merged.size() - 1);
+    nodeCount = (int)merged.size();
+}
+
+vector<Komik *> BST::collectAfter(const Komik *after, size_t limit) const
+{
+    METRIC_TIMER("bst.collectAfter");
+    vector<Komik *> page;
+    vector<Komik *> stack;
+    Komik *node = root;
+
+    // Turun dari root: simpan hanya node yang > after (calon in-order berikutnya)
+    while (node != nullptr)
+    {
+        if (after == nullptr || *after < *node)
+        {
+            stack.push_back(node);
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+
+    // Lanjutkan in-order iteratif sampai halaman penuh
+    while (!stack.empty() && page.size() < limit)
+    {
+        node = stack.back();
+        stack.pop_back();
+        page.push_back(node);
+
+        node = node->right;
+        while (node != nullptr)
+        {
+            stack.push_back(node);
+            node = node->left;
+        }
+    }
+
+    return page;
+}
+
+void BST::collectNodes(Komik *node, vector<Komik *> &nodes) const
+{
+    // Iteratif supaya aman untuk tree yang sangat tidak seimbang
+    vector<Komik *> stack;
+
+    while (node != nullptr || !stack.empty())
+    {
+        while (node != nullptr)
+        {
+            stack.push_back(node);
+            node = node->left;
+        }
+
+        node = stack.back();
+        stack.pop_back();
+        nodes.push_back(node);
+        node = node->right;
+    }
+}
+
 // ===== FIND BY KEYWORD (Interactive Helper with Clear UI) =====
 Komik *BST::findByKeyword(const string &keyword) const
 {
@@ -415,10 +685,18 @@ Komik *BST::findByKeyword(const string &keyword) const
     // ===== SMART SORTING =====
     string lowerKeyword = toLowerCase(keyword);
 
-    sort(results.begin(), results.end(), [&lowerKeyword, this](Komik *a, Komik *b)
+    // Title di-lowercase sekali per hasil, bukan dua kali per perbandingan
+    vector<pair<string, Komik *>> ranked;
+    ranked.reserve(results.size());
+    for (Komik *comic : results)
+        ranked.push_back(make_pair(toLowerCase(comic->title), comic));
+
+    sort(ranked.begin(), ranked.end(), [&lowerKeyword](const pair<string, Komik *> &left, const pair<string, Komik *> &right)
          {
-        string lowerA = toLowerCase(a->title);
-        string lowerB = toLowerCase(b->title);
+        const string &lowerA = left.first;
+        const string &lowerB = right.first;
+        const Komik *a = left.second;
+        const Komik *b = right.second;
         
         // 1. Exact match
         bool exactA = (lowerA == lowerKeyword);
@@ -438,6 +716,9 @@ Komik *BST::findByKeyword(const string &keyword) const
         // 4. Alphabetical
         return lowerA < lowerB; });
 
+    for (size_t i = 0; i < ranked.size(); i++)
+        results[i] = ranked[i].second;
+
     // ===== KALAU CUMA 1 HASIL =====
     if (results.size() == 1)
     {
@@ -452,21 +733,19 @@ Komik *BST::findByKeyword(const string &keyword) const
          << endl;
 
     // Tampilkan dengan format tabel
-    cout << left << setw(5) << "No."
-         << setw(35) << "Title"
-         << setw(25) << "Author" << endl;
-    cout << string(75, '-') << endl;
+    TableRenderer table;
+    table.setColumns({5, 35, 25});
+    table.headerRow({"No.", "Title", "Author"});
+    table.separator(75);
 
     for (size_t i = 0; i < results.size(); i++)
     {
-        cout << left << setw(5) << (i + 1)
-             << setw(35) << results[i]->title
-             << setw(25) << results[i]->author;
-
-        cout << endl;
+        table.cell((long long)(i + 1)).cell(results[i]->title).cell(results[i]->author);
+        table.endRow();
     }
 
-    cout << string(75, '-') << endl;
+    table.separator(75);
+    table.flush();
 
     // ===== INPUT PILIHAN =====
     int choice;
@@ -0,0 +1,403 @@
+/*
+ * BatchRunner.cpp
+ * Eksekusi command batch tanpa UI (untuk sync katalog / script)
+ */
+
+#include "../include/BatchRunner.h"
+#include "../include/Auth.h"
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+BatchRunner::BatchRunner(BST &tree, KomikManager &manager, Database &db)
+    : tree(tree), manager(manager), db(db), groupSize(500), pendingWrites(0), inTransaction(false),
+      groupFirstLine(0), currentLine(0)
+{
+    reloadState();
+}
+
+void BatchRunner::reloadState()
+{
+    knownAuthors.clear();
+    knownGenres.clear();
+    knownUsers.clear();
+
+    vector<string> authors = manager.getAllAuthors();
+    knownAuthors.insert(authors.begin(), authors.end());
+
+    vector<string> genres = manager.getAllGenres();
+    knownGenres.insert(genres.begin(), genres.end());
+
+    vector<User> users = db.getAllUsers();
+    for (const User &user : users)
+    {
+        knownUsers.insert(user.username);
+    }
+}
+
+// ===== DESTRUCTOR =====
+BatchRunner::~BatchRunner()
+{
+    commitGroup();
+}
+
+void BatchRunner::setGroupSize(int size)
+{
+    groupSize = size > 0 ? size : 1;
+}
+
+// ===== HELPER: SPLIT FIELDS =====
+vector<string> BatchRunner::splitFields(const string &line)
+{
+    vector<string> fields;
+    char delimiter = line.find('\t') != string::npos ? '\t' : '|';
+
+    size_t start = 0;
+    while (true)
+    {
+        size_t end = line.find(delimiter, start);
+        string field = line.substr(start, end == string::npos ? string::npos : end - start);
+
+        // Trim spasi di awal/akhir (dan '\r' dari file Windows)
+        size_t first = field.find_first_not_of(" \r");
+        size_t last = field.find_last_not_of(" \r");
+        fields.push_back(first == string::npos ? "" : field.substr(first, last - first + 1));
+
+        if (end == string::npos)
+            break;
+        start = end + 1;
+    }
+
+    return fields;
+}
+
+// Semua genre harus ada di tabel genres (sama seperti pilihan di menu)
+bool BatchRunner::validateGenres(const string &genreList, string &error) const
+{
+    stringstream ss(genreList);
+    string genre;
+    bool any = false;
+
+    while (getline(ss, genre, ','))
+    {
+        size_t first = genre.find_first_not_of(' ');
+        if (first == string::npos)
+            continue;
+        size_t last = genre.find_last_not_of(' ');
+        genre = genre.substr(first, last - first + 1);
+
+        if (!knownGenres.count(genre))
+        {
+            error = "unknown genre '" + genre + "'";
+            return false;
+        }
+        any = true;
+    }
+
+    if (!any)
+    {
+        error = "genre cannot be empty";
+        return false;
+    }
+    return true;
+}
+
+// Author baru otomatis ditambahkan (seperti "[Add New Author]" di menu)
+bool BatchRunner::ensureAuthor(const string &author)
+{
+    if (knownAuthors.count(author))
+        return true;
+
+    beginWrite();
+    if (!db.insertAuthor(author))
+        return false;
+
+    knownAuthors.insert(author);
+    return true;
+}
+
+// ===== TRANSACTION GROUPING =====
+
+void BatchRunner::beginWrite()
+{
+    if (!inTransaction)
+    {
+        inTransaction = db.beginTransaction();
+        groupFirstLine = currentLine;
+    }
+}
+
+bool BatchRunner::commitGroup(int *rolledBack)
+{
+    bool ok = true;
+    if (rolledBack)
+        *rolledBack = 0;
+
+    if (inTransaction && !db.commitTransaction())
+    {
+        // Misal SQLITE_BUSY: transaction masih terbuka, harus di-rollback manual
+        if (db.inTransaction())
+            db.rollbackTransaction();
+
+        // Tree dan cache sudah memuat write group ini, samakan lagi dengan database
+        ok = false;
+        if (rolledBack)
+            *rolledBack = pendingWrites;
+        manager.reloadFromDB(tree);
+        reloadState();
+    }
+    inTransaction = false;
+    pendingWrites = 0;
+    return ok;
+}
+
+// ===== COMMANDS =====
+
+bool BatchRunner::cmdAdd(const vector<string> &fields, string &error)
+{
+    if (fields.size() != 4 || fields[1].empty() || fields[2].empty())
+    {
+        error = "usage: add|title|author|genre";
+        return false;
+    }
+
+    if (!validateGenres(fields[3], error))
+        return false;
+
+    if (!ensureAuthor(fields[2]))
+    {
+        error = "failed to add author '" + fields[2] + "'";
+        return false;
+    }
+
+    Komik *komik = new Komik(manager.getNextId(), fields[1], fields[2], fields[3]);
+
+    beginWrite();
+    if (!db.insertKomik(komik))
+    {
+        delete komik;
+        error = "database insert failed";
+        return false;
+    }
+
+    tree.insert(komik);
+    return true;
+}
+
+bool BatchRunner::cmdUpdate(const vector<string> &fields, string &error)
+{
+    if (fields.size() != 5 || fields[1].empty())
+    {
+        error = "usage: update|oldTitle|newTitle|author|genre";
+        return false;
+    }
+
+    Komik *found = tree.search(fields[1]);
+    if (found == nullptr)
+    {
+        error = "komik not found: '" + fields[1] + "'";
+        return false;
+    }
+
+    string title = fields[2].empty() ? found->title : fields[2];
+    string author = fields[3].empty() ? found->author : fields[3];
+    string genre = fields[4].empty() ? found->genre : fields[4];
+
+    if (!validateGenres(genre, error))
+        return false;
+
+    if (!ensureAuthor(author))
+    {
+        error = "failed to add author '" + author + "'";
+        return false;
+    }
+
+    Komik *updated = new Komik(found->id, title, author, genre);
+
+    beginWrite();
+    if (!db.updateKomik(updated->id, updated))
+    {
+        delete updated;
+        error = "database update failed";
+        return false;
+    }
+
+    tree.update(fields[1], updated);
+    return true;
+}
+
+bool BatchRunner::cmdDelete(const vector<string> &fields, string &error)
+{
+    if (fields.size() != 2 || fields[1].empty())
+    {
+        error = "usage: delete|title";
+        return false;
+    }
+
+    Komik *found = tree.search(fields[1]);
+    if (found == nullptr)
+    {
+        error = "komik not found: '" + fields[1] + "'";
+        return false;
+    }
+
+    beginWrite();
+    if (!db.deleteKomik(found->id))
+    {
+        error = "database delete failed";
+        return false;
+    }
+
+    manager.forgetKomik(found->id);
+    tree.remove(fields[1]);
+    return true;
+}
+
+bool BatchRunner::cmdFavorite(const vector<string> &fields, bool add, string &error)
+{
+    if (fields.size() != 3 || fields[1].empty() || fields[2].empty())
+    {
+        error = add ? "usage: fav|username|title" : "usage: unfav|username|title";
+        return false;
+    }
+
+    if (!knownUsers.count(fields[1]))
+    {
+        error = "user not found: '" + fields[1] + "'";
+        return false;
+    }
+
+    Komik *found = tree.search(fields[2]);
+    if (found == nullptr)
+    {
+        error = "komik not found: '" + fields[2] + "'";
+        return false;
+    }
+
+    beginWrite();
+    bool ok = add ? manager.addFavorite(fields[1], found->id)
+                  : manager.removeFavorite(fields[1], found->id);
+    if (!ok)
+    {
+        error = "database favorite update failed";
+    }
+    return ok;
+}
+
+bool BatchRunner::cmdSearch(const vector<string> &fields, ostream &out, string &error)
+{
+    if (fields.size() != 2 || fields[1].empty())
+    {
+        error = "usage: search|keyword";
+        return false;
+    }
+
+    vector<Komik *> results = tree.searchPartial(fields[1]);
+    for (Komik *comic : results)
+    {
+        out << "RESULT\t" << comic->id << '\t' << comic->title << '\t'
+            << comic->author << '\t' << comic->genre << '\n';
+    }
+    return true;
+}
+
+// ===== RUN =====
+int BatchRunner::run(istream &in, ostream &out)
+{
+    auto start = chrono::steady_clock::now();
+
+    string line;
+    long lineNumber = 0, executed = 0, failed = 0;
+
+    // Commit group gagal: semua write di group itu dihitung gagal
+    auto commitOrReport = [this, &out, &failed, &lineNumber]()
+    {
+        long firstLine = groupFirstLine;
+        int rolledBack;
+        if (!commitGroup(&rolledBack))
+        {
+            failed += rolledBack;
+            out << "ERR lines " << firstLine << "-" << lineNumber << ": commit failed, " << rolledBack
+                << " write(s) rolled back\n";
+        }
+    };
+
+    while (getline(in, line))
+    {
+        lineNumber++;
+        currentLine = lineNumber;
+
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#')
+            continue;
+
+        vector<string> fields = splitFields(line.substr(first));
+        const string &command = fields[0];
+        string error;
+        bool ok;
+        bool isWrite = false;
+
+        if (command == "add")
+        {
+            ok = cmdAdd(fields, error);
+            isWrite = true;
+        }
+        else if (command == "update")
+        {
+            ok = cmdUpdate(fields, error);
+            isWrite = true;
+        }
+        else if (command == "delete")
+        {
+            ok = cmdDelete(fields, error);
+            isWrite = true;
+        }
+        else if (command == "fav" || command == "unfav")
+        {
+            ok = cmdFavorite(fields, command == "fav", error);
+            isWrite = true;
+        }
+        else if (command == "search")
+        {
+            ok = cmdSearch(fields, out, error);
+        }
+        else if (command == "commit")
+        {
+            commitOrReport();
+            ok = true;
+        }
+        else
+        {
+            error = "unknown command '" + command + "'";
+            ok = false;
+        }
+
+        executed++;
+        if (!ok)
+        {
+            failed++;
+            out << "ERR line " << lineNumber << ": " << error << '\n';
+        }
+
+        if (isWrite && ok && ++pendingWrites >= groupSize)
+        {
+            commitOrReport();
+        }
+    }
+
+    commitOrReport();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double opsPerSec = seconds > 0 ? executed / seconds : 0;
+
+    out << "DONE commands=" << executed
+        << " ok=" << (executed - failed)
+        << " failed=" << failed
+        << " elapsed_ms=" << (long)(seconds * 1000)
+        << " ops_per_sec=" << (long)opsPerSec << '\n';
+    out.flush();
+
+    return (int)failed;
+}
@@ -0,0 +1,365 @@
+/*
+ * CatalogGenerator.cpp
+ * Data katalog sintetis (seeded) untuk benchmark dan stress test
+ */
+
+#include "../include/CatalogGenerator.h"
+#include "../include/Auth.h"
+#include "../include/Exporter.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <set>
+
+using namespace std;
+
+static const char *TITLE_ADJECTIVES[] = {
+    "Dark", "Silent", "Crimson", "Last", "Eternal", "Hidden", "Broken", "Golden", "Lost", "Wild",
+    "Frozen", "Burning", "Secret", "Little", "Great", "Midnight", "Iron", "Shadow", "Blue", "Cursed",
+    "Fallen", "Sacred", "Endless", "Forgotten", "Brave", "Lonely", "Savage", "Spring", "Hollow", "Bright"};
+
+static const char *TITLE_NOUNS[] = {
+    "Blade", "Kingdom", "Dragon", "Academy", "Hero", "Garden", "Witch", "Ocean", "Empire", "Hunter",
+    "Moon", "Samurai", "Knight", "Island", "Tower", "Ghost", "Prince", "Storm", "Alchemist", "Detective",
+    "Festival", "Rebellion", "Spirit", "Voyage", "Demon", "Library", "Circus", "Village", "Machine", "Legend",
+    "Guardian", "Mountain", "Promise", "Signal", "Journey", "Chef", "Pilot", "Orchestra", "Frontier", "Sword"};
+
+static const char *TITLE_PATTERNS[] = {
+    "%A %N", "The %A %N", "%N", "%N of the %A %N", "%A %N Chronicles", "My %A %N", "%N Academy",
+    "The %N and the %N", "%A %N: %A %N", "Tales of the %A %N", "%A %A %N"};
+
+static const char *FIRST_NAMES[] = {
+    "Akira", "Yuki", "Haruto", "Sakura", "Kenji", "Aoi", "Ren", "Hina", "Sora", "Takumi",
+    "Mei", "Daichi", "Rina", "Kaito", "Nanami", "Budi", "Sari", "Dewi", "Rizky", "Ayu"};
+
+static const char *LAST_NAMES[] = {
+    "Tanaka", "Suzuki", "Sato", "Watanabe", "Yamamoto", "Nakamura", "Kobayashi", "Kato", "Yoshida", "Yamada",
+    "Sasaki", "Matsumoto", "Inoue", "Kimura", "Hayashi", "Santoso", "Wijaya", "Pratama", "Saputra", "Hidayat"};
+
+// Urut abjad seperti nama genre di database; bobot = seberapa sering muncul
+static const char *GENRE_NAMES[] = {"Action", "Comedy", "Drama", "Fantasy", "Horror", "Mystery", "Romance", "Sci-Fi"};
+static const double GENRE_WEIGHTS[] = {0.24, 0.16, 0.14, 0.15, 0.06, 0.07, 0.12, 0.06};
+const int GENRE_COUNT = 8;
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+// ===== CONSTRUCTOR =====
+CatalogGenerator::CatalogGenerator(const GeneratorConfig &cfg) : config(cfg), rng(cfg.seed)
+{
+}
+
+// ===== RANDOM HELPERS =====
+unsigned int CatalogGenerator::pick(unsigned int n)
+{
+    return n == 0 ? 0 : rng() % n;
+}
+
+double CatalogGenerator::uniform()
+{
+    return rng() / 4294967296.0; // [0, 1)
+}
+
+// CDF Zipf: peluang rank k sebanding 1 / k^s
+vector<double> CatalogGenerator::zipfCdf(size_t n, double exponent)
+{
+    vector<double> cdf(n);
+    double sum = 0;
+    for (size_t k = 0; k < n; k++)
+    {
+        sum += 1.0 / pow((double)(k + 1), exponent);
+        cdf[k] = sum;
+    }
+    for (size_t k = 0; k < n; k++)
+        cdf[k] /= sum;
+    return cdf;
+}
+
+size_t CatalogGenerator::sampleCdf(const vector<double> &cdf)
+{
+    size_t index = lower_bound(cdf.begin(), cdf.end(), uniform()) - cdf.begin();
+    return index < cdf.size() ? index : cdf.size() - 1;
+}
+
+// ===== CATALOG CONTENT =====
+
+void CatalogGenerator::prepareAuthors()
+{
+    // Kira-kira satu author per 20 komik, minimal 20
+    size_t count = max<size_t>(20, (size_t)(config.comics / 20));
+    set<string> used;
+    authorNames.clear();
+
+    while (authorNames.size() < count)
+    {
+        string first = FIRST_NAMES[pick(COUNT_OF(FIRST_NAMES))];
+        string last = LAST_NAMES[pick(COUNT_OF(LAST_NAMES))];
+        string name = first + " " + last;
+
+        // Kombinasi nama terbatas: pakai inisial tengah, baru nomor kalau masih kembar
+        for (int attempt = 0; attempt < 8 && used.count(name); attempt++)
+            name = first + " " + (char)('A' + pick(26)) + ". " + last;
+        if (used.count(name))
+            name += " " + to_string(authorNames.size());
+        used.insert(name);
+        authorNames.push_back(name);
+    }
+
+    authorCdf = zipfCdf(authorNames.size(), 0.8);
+}
+
+string CatalogGenerator::buildTitle()
+{
+    string pattern = TITLE_PATTERNS[pick(COUNT_OF(TITLE_PATTERNS))];
+    string title;
+
+    for (size_t i = 0; i < pattern.size(); i++)
+    {
+        if (pattern[i] == '%' && i + 1 < pattern.size())
+        {
+            title += pattern[i + 1] == 'A' ? TITLE_ADJECTIVES[pick(COUNT_OF(TITLE_ADJECTIVES))]
+                                           : TITLE_NOUNS[pick(COUNT_OF(TITLE_NOUNS))];
+            i++;
+        }
+        else
+        {
+            title += pattern[i];
+        }
+    }
+
+    // Seri panjang: sebagian title punya nomor volume / season
+    unsigned int roll = pick(100);
+    if (roll < 15)
+        title += " Vol. " + to_string(1 + pick(30));
+    else if (roll < 20)
+        title += " Season " + to_string(2 + pick(4));
+
+    return title;
+}
+
+string CatalogGenerator::makeTitle(unordered_set<string> &usedTitles)
+{
+    // Title pendek cepat habis kombinasinya; acak ulang beberapa kali dulu,
+    // baru kalau tetap kembar diberi nomor edisi
+    string title = buildTitle();
+    for (int attempt = 0; attempt < 8 && usedTitles.count(title); attempt++)
+        title = buildTitle();
+
+    string unique = title;
+    for (int edition = 2; usedTitles.count(unique); edition++)
+        unique = title + " (" + to_string(edition) + ")";
+
+    usedTitles.insert(unique);
+    return unique;
+}
+
+string CatalogGenerator::makeGenres()
+{
+    // Jumlah genre: 1 (35%), 2 (40%), 3 (20%), 4 (5%)
+    unsigned int roll = pick(100);
+    int count = roll < 35 ? 1 : (roll < 75 ? 2 : (roll < 95 ? 3 : 4));
+
+    bool chosen[GENRE_COUNT] = {false};
+    int picked = 0;
+    while (picked < count)
+    {
+        double r = uniform(), acc = 0;
+        int g = GENRE_COUNT - 1;
+        for (int i = 0; i < GENRE_COUNT; i++)
+        {
+            acc += GENRE_WEIGHTS[i];
+            if (r < acc)
+            {
+                g = i;
+                break;
+            }
+        }
+        if (!chosen[g])
+        {
+            chosen[g] = true;
+            picked++;
+        }
+    }
+
+    string genres;
+    for (int i = 0; i < GENRE_COUNT; i++)
+    {
+        if (!chosen[i])
+            continue;
+        if (!genres.empty())
+            genres += ", ";
+        genres += GENRE_NAMES[i];
+    }
+    return genres;
+}
+
+// ===== OUTPUT: MEMORY =====
+vector<Komik *> CatalogGenerator::generateKomiks(int firstId)
+{
+    prepareAuthors();
+
+    unordered_set<string> usedTitles;
+    vector<Komik *> komiks;
+    komiks.reserve(config.comics);
+
+    for (long i = 0; i < config.comics; i++)
+    {
+        string title = makeTitle(usedTitles);
+        const string &author = authorNames[sampleCdf(authorCdf)];
+        komiks.push_back(new Komik(firstId + (int)i, title, author, makeGenres()));
+    }
+    return komiks;
+}
+
+// ===== OUTPUT: DATABASE =====
+// Satu transaction untuk semua insert; komik masuk lewat insertKomiksBulk
+// per chunk supaya memory tidak perlu menampung seluruh katalog sekaligus.
+bool CatalogGenerator::writeDatabase(Database &db, GeneratorReport &report)
+{
+    auto start = chrono::steady_clock::now();
+    const size_t CHUNK = 10000;
+
+    prepareAuthors();
+
+    if (!db.beginTransaction())
+        return false;
+
+    for (const string &name : authorNames)
+        db.insertAuthor(name);
+    for (int g = 0; g < GENRE_COUNT; g++)
+        db.insertGenre(GENRE_NAMES[g]);
+
+    int firstId = db.getLastKomikId() + 1;
+    unordered_set<string> usedTitles;
+    vector<Komik *> chunk;
+    chunk.reserve(CHUNK);
+    bool ok = true;
+
+    for (long i = 0; i < config.comics && ok; i++)
+    {
+        string title = makeTitle(usedTitles);
+        const string &author = authorNames[sampleCdf(authorCdf)];
+        chunk.push_back(new Komik(firstId + (int)i, title, author, makeGenres()));
+
+        if (chunk.size() == CHUNK || i == config.comics - 1)
+        {
+            ok = db.insertKomiksBulk(chunk) == (int)chunk.size();
+            for (Komik *komik : chunk)
+                delete komik;
+            chunk.clear();
+        }
+    }
+
+    // User: username = password = "genNNNNN" (bisa langsung dipakai login / loadgen)
+    int firstUserId = db.getLastUserId() + 1;
+    vector<string> usernames;
+    for (int u = 0; u < config.users && ok; u++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "gen%05d", firstUserId + u);
+        User user(firstUserId + u, name, Auth::hashPassword(name), "user");
+        ok = db.insertUser(user);
+        usernames.push_back(name);
+    }
+
+    // Favorites: user uniform, komik Zipf atas urutan acak (komik populer
+    // tersebar, bukan selalu id terkecil). Pasangan kembar dilewati.
+    long favorites = 0;
+    if (ok && config.favorites > 0 && !usernames.empty() && config.comics > 0)
+    {
+        vector<int> rankToId(config.comics);
+        for (long i = 0; i < config.comics; i++)
+            rankToId[i] = firstId + (int)i;
+        for (long i = config.comics - 1; i > 0; i--)
+            swap(rankToId[i], rankToId[pick((unsigned int)i + 1)]);
+
+        vector<double> comicCdf = zipfCdf(rankToId.size(), config.zipfExponent);
+        set<pair<size_t, int>> usedPairs;
+        long attempts = 0, maxAttempts = config.favorites * 4;
+
+        while (favorites < config.favorites && attempts++ < maxAttempts && ok)
+        {
+            size_t userIndex = pick((unsigned int)usernames.size());
+            int komikId = rankToId[sampleCdf(comicCdf)];
+            if (!usedPairs.insert(make_pair(userIndex, komikId)).second)
+                continue;
+
+            ok = db.addFavorite(usernames[userIndex], komikId);
+            favorites++;
+        }
+    }
+
+    if (!ok)
+    {
+        db.rollbackTransaction();
+        cerr << "Generate gagal, transaction di-rollback" << endl;
+        return false;
+    }
+
+    if (!db.commitTransaction())
+        return false;
+
+    report.comics = config.comics;
+    report.users = (int)usernames.size();
+    report.favorites = favorites;
+    report.authors = (int)authorNames.size();
+    report.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// ===== OUTPUT: CSV =====
+// Hanya komiks (format --import); users / favorites butuh output database.
+bool CatalogGenerator::writeCsv(const string &path, GeneratorReport &report)
+{
+    auto start = chrono::steady_clock::now();
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        cerr << "Tidak bisa membuka file: " << path << endl;
+        return false;
+    }
+
+    prepareAuthors();
+
+    unordered_set<string> usedTitles;
+    string buffer = "title,author,genre\n";
+    bool ok = true;
+
+    for (long i = 0; i < config.comics && ok; i++)
+    {
+        string title = makeTitle(usedTitles);
+        const string &author = authorNames[sampleCdf(authorCdf)];
+        string genres = makeGenres();
+
+        Exporter::appendCsvField(buffer, title.c_str(), (int)title.size());
+        buffer += ',';
+        Exporter::appendCsvField(buffer, author.c_str(), (int)author.size());
+        buffer += ',';
+        Exporter::appendCsvField(buffer, genres.c_str(), (int)genres.size());
+        buffer += '\n';
+
+        if (buffer.size() >= 256 * 1024)
+        {
+            ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+    }
+
+    if (ok && !buffer.empty())
+        ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    if (fclose(file) != 0)
+        ok = false;
+
+    if (!ok)
+    {
+        cerr << "Gagal menulis file: " << path << endl;
+        return false;
+    }
+
+    report.comics = config.comics;
+    report.authors = (int)authorNames.size();
+    report.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    return true;
+}
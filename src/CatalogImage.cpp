@@ -0,0 +1,115 @@
+/*
+ * CatalogImage.cpp
+ * Katalog read-only di atas file snapshot yang di-memory-map
+ */
+
+#include "../include/CatalogImage.h"
+#include <iostream>
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+CatalogImage::CatalogImage() : header(nullptr), records(nullptr), pool(nullptr), count(0) {}
+
+// ===== DESTRUCTOR =====
+CatalogImage::~CatalogImage()
+{
+    close();
+}
+
+bool CatalogImage::open(const string &path)
+{
+    close();
+
+    if (!file.open(path))
+    {
+        cerr << "Cannot open catalog file: " << path << endl;
+        return false;
+    }
+
+    // Header + batas nodeCount/poolSize dicek sebelum record di-index
+    SnapshotHeader checked;
+    string error;
+    if (!Snapshot::readHeader(file.getData(), file.size(), checked, error))
+    {
+        cerr << "Invalid catalog file: " << error << "." << endl;
+        file.close();
+        return false;
+    }
+
+    const SnapshotHeader *h = reinterpret_cast<const SnapshotHeader *>(file.getData());
+    uint64_t recordSize = h->nodeCount * sizeof(SnapshotRecord);
+
+    header = h;
+    records = reinterpret_cast<const SnapshotRecord *>(file.getData() + sizeof(SnapshotHeader));
+    pool = file.getData() + sizeof(SnapshotHeader) + recordSize;
+    count = (size_t)h->nodeCount;
+    return true;
+}
+
+void CatalogImage::close()
+{
+    file.close();
+    header = nullptr;
+    records = nullptr;
+    pool = nullptr;
+    count = 0;
+}
+
+bool CatalogImage::isOpen() const
+{
+    return header != nullptr;
+}
+
+bool CatalogImage::verify() const
+{
+    if (!isOpen())
+        return false;
+
+    const char *payload = reinterpret_cast<const char *>(records);
+    size_t recordSize = count * sizeof(SnapshotRecord);
+
+    return Snapshot::checksum(pool, header->poolSize, Snapshot::checksum(payload, recordSize)) == header->checksum;
+}
+
+bool CatalogImage::getEntry(size_t index, CatalogEntry &entry) const
+{
+    if (index >= count)
+        return false;
+
+    const SnapshotRecord &rec = records[index];
+    entry.id = rec.id;
+
+    return Snapshot::readString(pool, header->poolSize, rec.titleOffset, entry.title, entry.titleLength) &&
+           Snapshot::readString(pool, header->poolSize, rec.authorOffset, entry.author, entry.authorLength) &&
+           Snapshot::readString(pool, header->poolSize, rec.genreOffset, entry.genre, entry.genreLength);
+}
+
+// ===== FIND BY TITLE (binary search, exact match) =====
+long CatalogImage::findByTitle(const string &title) const
+{
+    size_t low = 0, high = count;
+
+    // Cari posisi pertama dengan title >= yang dicari (lower bound)
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        CatalogEntry entry;
+        if (!getEntry(mid, entry))
+            return -1;
+
+        if (title.compare(0, string::npos, entry.title, entry.titleLength) > 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    CatalogEntry entry;
+    if (low < count && getEntry(low, entry) &&
+        title.compare(0, string::npos, entry.title, entry.titleLength) == 0)
+    {
+        return (long)low;
+    }
+
+    return -1;
+}
@@ -0,0 +1,535 @@
+/*
+ * CatalogServer.cpp
+ * Multi-session server di atas Unix domain socket: event loop + thread pool per request
+ */
+
+#include "../include/CatalogServer.h"
+#include "../include/BatchRunner.h"
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace std;
+
+const size_t MAX_LINE_LENGTH = 64 * 1024;
+
+// ===== CONSTRUCTOR =====
+CatalogServer::CatalogServer(BST &tree, KomikManager &manager, Database &db, Auth &auth)
+    : catalog(tree), manager(manager), db(db), auth(auth),
+      threadCount(8), running(false), listenFd(-1)
+{
+    wakePipe[0] = wakePipe[1] = -1;
+    versions.loadFrom(tree);
+}
+
+// ===== DESTRUCTOR =====
+CatalogServer::~CatalogServer()
+{
+    stop();
+}
+
+void CatalogServer::setThreadCount(int count)
+{
+    threadCount = count > 0 ? count : 1;
+}
+
+void CatalogServer::stop()
+{
+    running.store(false);
+}
+
+// ===== RESPONSE HELPERS =====
+
+void CatalogServer::appendKomik(string &response, const Komik &comic) const
+{
+    response += "RESULT\t";
+    response += to_string(comic.id);
+    response += '\t';
+    response += comic.title;
+    response += '\t';
+    response += comic.author;
+    response += '\t';
+    response += comic.genre;
+    response += '\n';
+}
+
+// RESULT\tid\tvalue\ttitle, title dicari dengan satu kali traversal
+void CatalogServer::appendTitled(string &response, const vector<pair<int, int>> &idValues)
+{
+    unordered_map<int, string> titles;
+    for (const pair<int, int> &entry : idValues)
+        titles[entry.first] = "Unknown";
+
+    versions.snapshot().inOrder([&titles](const Komik &comic)
+                                {
+        unordered_map<int, string>::iterator it = titles.find(comic.id);
+        if (it != titles.end())
+            it->second = comic.title; });
+
+    for (const pair<int, int> &entry : idValues)
+    {
+        response += "RESULT\t" + to_string(entry.first) + '\t' + to_string(entry.second) + '\t' + titles[entry.first] + '\n';
+    }
+}
+
+// ===== COMMAND DISPATCH =====
+// Return false kalau koneksi harus ditutup (quit)
+bool CatalogServer::handleCommand(const string &line, Session &session, string &response)
+{
+    vector<string> fields = BatchRunner::splitFields(line);
+    const string &command = fields[0];
+
+    if (command == "ping")
+    {
+        response += "OK pong\n";
+    }
+    else if (command == "quit")
+    {
+        response += "OK bye\n";
+        return false;
+    }
+    else if (command == "login")
+    {
+        if (fields.size() != 3)
+        {
+            response += "ERR usage: login|username|password\n";
+            return true;
+        }
+
+        User user;
+        bool ok;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            ok = auth.authenticate(fields[1], fields[2], user);
+        }
+
+        if (!ok)
+        {
+            response += "ERR invalid username or password\n";
+            return true;
+        }
+        session.username = user.username;
+        session.role = user.role;
+        response += "OK " + user.role + "\n";
+    }
+    else if (command == "search")
+    {
+        if (fields.size() != 2 || fields[1].empty())
+        {
+            response += "ERR usage: search|keyword\n";
+            return true;
+        }
+
+        vector<Komik> results = versions.snapshot().searchPartial(fields[1]);
+        for (const Komik &comic : results)
+            appendKomik(response, comic);
+        response += "OK " + to_string(results.size()) + "\n";
+    }
+    else if (command == "get")
+    {
+        Komik comic;
+        if (fields.size() != 2 || !versions.snapshot().search(fields[1], comic))
+        {
+            response += "ERR komik not found\n";
+            return true;
+        }
+        appendKomik(response, comic);
+        response += "OK 1\n";
+    }
+    else if (command == "list")
+    {
+        int limit = fields.size() > 1 ? atoi(fields[1].c_str()) : 20;
+        if (limit <= 0)
+            limit = 20;
+
+        vector<Komik> page = versions.snapshot().collectAfter(nullptr, limit);
+        for (const Komik &comic : page)
+            appendKomik(response, comic);
+        response += "OK " + to_string(page.size()) + "\n";
+    }
+    else if (command == "count")
+    {
+        response += "OK " + to_string(versions.snapshot().count()) + "\n";
+    }
+    else if (command == "top")
+    {
+        int n = fields.size() > 1 ? atoi(fields[1].c_str()) : 10;
+        vector<pair<int, int>> top;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            top = manager.getTopFavorited(n > 0 ? n : 10);
+        }
+        appendTitled(response, top);
+        response += "OK " + to_string(top.size()) + "\n";
+    }
+    else if (command == "favs" || command == "fav" || command == "unfav")
+    {
+        if (session.username.empty())
+        {
+            response += "ERR login required\n";
+            return true;
+        }
+
+        if (command == "favs")
+        {
+            vector<int> ids;
+            {
+                lock_guard<mutex> guard(stateMutex);
+                ids = manager.getFavoritesByUser(session.username);
+            }
+            vector<pair<int, int>> idValues;
+            for (int id : ids)
+                idValues.push_back(make_pair(id, 1));
+            appendTitled(response, idValues);
+            response += "OK " + to_string(ids.size()) + "\n";
+            return true;
+        }
+
+        Komik comic;
+        if (fields.size() != 2 || !versions.snapshot().search(fields[1], comic))
+        {
+            response += "ERR komik not found\n";
+            return true;
+        }
+
+        bool ok;
+        {
+            lock_guard<mutex> guard(stateMutex);
+            ok = command == "fav" ? manager.addFavorite(session.username, comic.id)
+                                  : manager.removeFavorite(session.username, comic.id);
+        }
+        response += ok ? "OK " + to_string(comic.id) + "\n" : string("ERR favorite update failed\n");
+    }
+    else if (command == "add" || command == "delete")
+    {
+        if (session.role != "admin")
+        {
+            response += "ERR admin only\n";
+            return true;
+        }
+
+        lock_guard<mutex> guard(stateMutex);
+
+        if (command == "add")
+        {
+            if (fields.size() != 4 || fields[1].empty() || fields[2].empty() || fields[3].empty())
+            {
+                response += "ERR usage: add|title|author|genre\n";
+                return true;
+            }
+
+            vector<string> authors = manager.getAllAuthors();
+            if (find(authors.begin(), authors.end(), fields[2]) == authors.end())
+            {
+                response += "ERR unknown author '" + fields[2] + "'\n";
+                return true;
+            }
+
+            // Semua genre harus sudah ada (sama seperti batch mode)
+            vector<string> genres = manager.getAllGenres();
+            stringstream genreList(fields[3]);
+            string genre;
+            while (getline(genreList, genre, ','))
+            {
+                size_t first = genre.find_first_not_of(' ');
+                size_t last = genre.find_last_not_of(' ');
+                genre = first == string::npos ? "" : genre.substr(first, last - first + 1);
+                if (find(genres.begin(), genres.end(), genre) == genres.end())
+                {
+                    response += "ERR unknown genre '" + genre + "'\n";
+                    return true;
+                }
+            }
+
+            Komik comic(manager.getNextId(), fields[1], fields[2], fields[3]);
+            if (!db.insertKomik(&comic))
+            {
+                response += "ERR database insert failed\n";
+                return true;
+            }
+            catalog.insert(comic);
+            versions.insert(comic);
+            response += "OK " + to_string(comic.id) + "\n";
+        }
+        else
+        {
+            Komik comic;
+            if (fields.size() != 2 || !versions.snapshot().search(fields[1], comic))
+            {
+                response += "ERR komik not found\n";
+                return true;
+            }
+            if (!db.deleteKomik(comic.id))
+            {
+                response += "ERR database delete failed\n";
+                return true;
+            }
+            catalog.remove(fields[1]);
+            versions.remove(fields[1]);
+            manager.forgetKomik(comic.id);
+            response += "OK " + to_string(comic.id) + "\n";
+        }
+    }
+    else
+    {
+        response += "ERR unknown command '" + command + "'\n";
+    }
+
+    return true;
+}
+
+#ifdef _WIN32
+
+int CatalogServer::run(const string &socketPath)
+{
+    cerr << "Server mode is not supported on Windows (needs Unix domain sockets)." << endl;
+    return 1;
+}
+
+void CatalogServer::workerLoop() {}
+bool CatalogServer::serveReady(Connection &connection) { return false; }
+
+#else
+
+// ===== CONNECTION =====
+
+static bool sendAll(int fd, const string &data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        sent += n;
+    }
+    return true;
+}
+
+bool CatalogServer::serveReady(Connection &connection)
+{
+    // Event loop baru mengirim koneksi ini kalau poll bilang ada data / hangup,
+    // jadi recv di sini tidak menunggu client
+    char chunk[4096];
+    ssize_t n;
+    do
+    {
+        n = recv(connection.fd, chunk, sizeof(chunk), 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+        return false;
+    connection.buffer.append(chunk, n);
+
+    // Proses semua baris lengkap, kirim response sekaligus (pipelining)
+    string response;
+    bool open = true;
+    size_t start = 0, newline;
+    while (open && (newline = connection.buffer.find('\n', start)) != string::npos)
+    {
+        string line = connection.buffer.substr(start, newline - start);
+        start = newline + 1;
+
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos)
+            continue;
+        open = handleCommand(line.substr(first), connection.session, response);
+    }
+    connection.buffer.erase(0, start);
+
+    if (connection.buffer.size() > MAX_LINE_LENGTH)
+    {
+        response += "ERR line too long\n";
+        open = false;
+    }
+
+    if (!response.empty() && !sendAll(connection.fd, response))
+        return false;
+    return open;
+}
+
+void CatalogServer::workerLoop()
+{
+    while (true)
+    {
+        Connection *connection;
+        {
+            unique_lock<mutex> guard(queueMutex);
+            queueCv.wait(guard, [this]
+                         { return !readyClients.empty() || !running.load(); });
+            if (!running.load())
+                return;
+            connection = readyClients.front();
+            readyClients.pop();
+        }
+
+        if (!serveReady(*connection))
+        {
+            ::close(connection->fd);
+            delete connection;
+            continue;
+        }
+
+        // Kembalikan ke event loop supaya di-poll lagi
+        {
+            lock_guard<mutex> guard(queueMutex);
+            returnedClients.push_back(connection);
+        }
+        char wake = 1;
+        if (write(wakePipe[1], &wake, 1) < 0)
+        {
+            // Pipe penuh: event loop memang sudah akan bangun
+        }
+    }
+}
+
+// ===== RUN =====
+int CatalogServer::run(const string &socketPath)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        cerr << "Socket path too long: " << socketPath << endl;
+        return 1;
+    }
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+    {
+        cerr << "Cannot create socket: " << strerror(errno) << endl;
+        return 1;
+    }
+
+    unlink(socketPath.c_str()); // socket lama dari run sebelumnya
+    if (::bind(listenFd, (sockaddr *)&address, sizeof(address)) < 0 || listen(listenFd, 128) < 0)
+    {
+        cerr << "Cannot listen on " << socketPath << ": " << strerror(errno) << endl;
+        ::close(listenFd);
+        listenFd = -1;
+        return 1;
+    }
+
+    if (pipe(wakePipe) < 0)
+    {
+        cerr << "Cannot create wake pipe: " << strerror(errno) << endl;
+        ::close(listenFd);
+        listenFd = -1;
+        return 1;
+    }
+    // Worker tidak boleh ke-block kalau pipe penuh (event loop pasti bangun)
+    fcntl(wakePipe[1], F_SETFL, fcntl(wakePipe[1], F_GETFL) | O_NONBLOCK);
+
+    running.store(true);
+    vector<thread> workers;
+    for (int i = 0; i < threadCount; i++)
+        workers.push_back(thread(&CatalogServer::workerLoop, this));
+
+    cout << "Listening on " << socketPath << " (" << threadCount << " worker threads)" << endl;
+
+    vector<Connection *> idle;
+    vector<pollfd> fds;
+    while (running.load())
+    {
+        // [0] listen, [1] wake pipe, sisanya koneksi idle (urutan sama dengan idle)
+        fds.resize(2 + idle.size());
+        fds[0].fd = listenFd;
+        fds[1].fd = wakePipe[0];
+        for (size_t i = 0; i < idle.size(); i++)
+            fds[2 + i].fd = idle[i]->fd;
+        for (pollfd &pfd : fds)
+        {
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+        }
+
+        if (poll(fds.data(), fds.size(), 200) <= 0)
+            continue;
+
+        // Koneksi yang siap diserahkan ke worker, sisanya tetap idle
+        vector<Connection *> stillIdle;
+        {
+            lock_guard<mutex> guard(queueMutex);
+            for (size_t i = 0; i < idle.size(); i++)
+            {
+                if (fds[2 + i].revents & (POLLIN | POLLHUP | POLLERR))
+                    readyClients.push(idle[i]);
+                else
+                    stillIdle.push_back(idle[i]);
+            }
+        }
+        if (stillIdle.size() != idle.size())
+            queueCv.notify_all();
+        idle.swap(stillIdle);
+
+        if (fds[1].revents & POLLIN)
+        {
+            char drain[256];
+            if (read(wakePipe[0], drain, sizeof(drain)) < 0)
+            {
+                // EINTR: sisa byte dibaca di putaran berikutnya
+            }
+            lock_guard<mutex> guard(queueMutex);
+            idle.insert(idle.end(), returnedClients.begin(), returnedClients.end());
+            returnedClients.clear();
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            int client = accept(listenFd, nullptr, nullptr);
+            if (client >= 0)
+            {
+                Connection *connection = new Connection();
+                connection->fd = client;
+                idle.push_back(connection);
+            }
+        }
+    }
+
+    // Shutdown: bangunkan semua worker, tutup semua koneksi yang tersisa
+    queueCv.notify_all();
+    for (thread &worker : workers)
+        worker.join();
+
+    while (!readyClients.empty())
+    {
+        idle.push_back(readyClients.front());
+        readyClients.pop();
+    }
+    idle.insert(idle.end(), returnedClients.begin(), returnedClients.end());
+    returnedClients.clear();
+    for (Connection *connection : idle)
+    {
+        ::close(connection->fd);
+        delete connection;
+    }
+
+    ::close(wakePipe[0]);
+    ::close(wakePipe[1]);
+    wakePipe[0] = wakePipe[1] = -1;
+
+    ::close(listenFd);
+    listenFd = -1;
+    unlink(socketPath.c_str());
+
+    cout << "Server stopped." << endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * ConcurrentCatalog.cpp
+ * Akses BST dari banyak thread dengan reader/writer lock
+ */
+
+#include "../include/ConcurrentCatalog.h"
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+ConcurrentCatalog::ConcurrentCatalog(BST &tree) : tree(tree) {}
+
+// Copy data saja, tanpa pointer anak
+Komik ConcurrentCatalog::copyOf(const Komik *comic)
+{
+    return Komik(comic->id, comic->title, comic->author, comic->genre);
+}
+
+// ===== READERS =====
+
+bool ConcurrentCatalog::search(const string &title, Komik &result) const
+{
+    ReadGuard guard(rw);
+    Komik *found = tree.search(title);
+    if (found == nullptr)
+        return false;
+
+    result = copyOf(found);
+    return true;
+}
+
+vector<Komik> ConcurrentCatalog::searchPartial(const string &keyword) const
+{
+    vector<Komik> results;
+    ReadGuard guard(rw);
+    for (Komik *comic : tree.searchPartial(keyword))
+    {
+        results.push_back(copyOf(comic));
+    }
+    return results;
+}
+
+vector<Komik> ConcurrentCatalog::getAllKomiks() const
+{
+    vector<Komik> results;
+    ReadGuard guard(rw);
+    for (Komik *comic : tree.getAllKomiks())
+    {
+        results.push_back(copyOf(comic));
+    }
+    return results;
+}
+
+vector<Komik> ConcurrentCatalog::page(const Komik *after, size_t limit) const
+{
+    vector<Komik> results;
+    ReadGuard guard(rw);
+    for (Komik *comic : tree.collectAfter(after, limit))
+    {
+        results.push_back(copyOf(comic));
+    }
+    return results;
+}
+
+int ConcurrentCatalog::count() const
+{
+    ReadGuard guard(rw);
+    return tree.count();
+}
+
+void ConcurrentCatalog::withReadLock(const function<void(const BST &)> &callback) const
+{
+    ReadGuard guard(rw);
+    callback(tree);
+}
+
+// ===== WRITERS =====
+
+void ConcurrentCatalog::insert(const Komik &comic)
+{
+    // Alokasi node di luar lock, critical section cukup untuk relink
+    Komik *node = new Komik(comic.id, comic.title, comic.author, comic.genre);
+    WriteGuard guard(rw);
+    tree.insert(node);
+}
+
+bool ConcurrentCatalog::remove(const string &title)
+{
+    WriteGuard guard(rw);
+    return tree.remove(title);
+}
+
+bool ConcurrentCatalog::update(const string &oldTitle, const Komik &updated)
+{
+    Komik *node = new Komik(updated.id, updated.title, updated.author, updated.genre);
+    WriteGuard guard(rw);
+    return tree.update(oldTitle, node); // BST::update menghapus node kalau gagal
+}
+
+void ConcurrentCatalog::withWriteLock(const function<void(BST &)> &callback)
+{
+    WriteGuard guard(rw);
+    callback(tree);
+}
@@ -1,11 +1,13 @@
 #include "../include/Database.h"
 #include "../include/Auth.h"
+#include "../include/Metrics.h"
 #include <iostream>
 #include <sstream>
+#include <fstream>
 
 using namespace std;
 
-Database::Database() : db(nullptr), dbPath("") {}
+Database::Database() : db(nullptr), dbPath(""), verbose(true) {}
 
 Database::~Database()
 {
@@ -23,17 +25,25 @@ bool Database::open(const string &path)
         return false;
     }
 
-    cout << "Database opened successfully: " << path << endl;
+    if (slowLog.isOpen())
+        slowLog.attach(db, "main");
+
+    if (verbose)
+        cout << "Database opened successfully: " << path << endl;
     return createTables();
 }
 
 void Database::close()
 {
+    // Semua mutation yang masih antre di-commit dulu sebelum koneksi ditutup
+    writeQueue.stop();
+
     if (db)
     {
         sqlite3_close(db);
         db = nullptr;
-        cout << "Database connection closed." << endl;
+        if (verbose)
+            cout << "Database connection closed." << endl;
     }
 }
 
@@ -42,6 +52,146 @@ bool Database::isOpen() const
     return db != nullptr;
 }
 
+// ===== WRITE-BEHIND =====
+
+bool Database::enableWriteBehind(int intervalMs, bool durableAck)
+{
+    if (!db)
+        return false;
+
+    // Koneksi utama menunggu (bukan langsung SQLITE_BUSY) saat writer sedang commit
+    sqlite3_busy_timeout(db, 5000);
+    return writeQueue.start(dbPath, intervalMs, durableAck);
+}
+
+// Dipanggil di awal setiap read / write sinkron: query di koneksi utama
+// harus melihat semua mutation yang sudah di-submit sebelumnya
+bool Database::flushWrites()
+{
+    if (writeQueue.flush())
+        return true;
+
+    // Non-durable: write sudah di-ack ke caller, jadi kegagalannya dilaporkan di sini
+    cerr << "\033[31mWrite-behind: " << writeQueue.getDiscardedCount()
+         << " write(s) total tidak tersimpan, terakhir: " << writeQueue.getLastError() << "\033[0m" << endl;
+    return false;
+}
+
+bool Database::submitWrite(const WriteRecord &record)
+{
+    if (writeQueue.isRunning())
+        return writeQueue.submit(record);
+
+    string error;
+    if (!record.apply(db, error))
+    {
+        cerr << record.errorLabel << ": " << error << endl;
+        return false;
+    }
+    return true;
+}
+
+// ===== SLOW QUERY LOG =====
+
+bool Database::enableSlowQueryLog(const string &path, double thresholdMs, long maxBytes, int maxFiles)
+{
+    if (!slowLog.open(path, thresholdMs, maxBytes, maxFiles))
+        return false;
+
+    if (db)
+        slowLog.attach(db, "main");
+    writeQueue.setSlowQueryLog(&slowLog);
+    return true;
+}
+
+void Database::disableSlowQueryLog()
+{
+    SlowQueryLog::detach(db);
+    writeQueue.setSlowQueryLog(nullptr);
+    slowLog.close();
+}
+
+// ===== TRANSACTION =====
+
+bool Database::execute(const string &sql)
+{
+    METRIC_TIMER("db.execute");
+    flushWrites();
+
+    if (!db)
+        return false;
+
+    char *errMsg = nullptr;
+    int rc = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK)
+    {
+        cerr << "SQL error: " << (errMsg ? errMsg : sqlite3_errmsg(db)) << endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    return true;
+}
+
+bool Database::beginTransaction()
+{
+    METRIC_TIMER("db.beginTransaction");
+    return execute("BEGIN TRANSACTION;");
+}
+
+bool Database::commitTransaction()
+{
+    METRIC_TIMER("db.commitTransaction");
+    return execute("COMMIT;");
+}
+
+bool Database::rollbackTransaction()
+{
+    METRIC_TIMER("db.rollbackTransaction");
+    return execute("ROLLBACK;");
+}
+
+bool Database::inTransaction() const
+{
+    return db && !sqlite3_get_autocommit(db);
+}
+
+// ===== CURSOR =====
+bool Database::forEachRow(const string &sql, const function<bool(sqlite3_stmt *)> &onRow)
+{
+    METRIC_TIMER("db.forEachRow");
+    flushWrites();
+
+    if (!db)
+        return false;
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        if (!onRow(stmt))
+        {
+            rc = SQLITE_DONE;
+            break;
+        }
+    }
+
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE)
+    {
+        cerr << "Query failed: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+    return true;
+}
+
 bool Database::createTables()
 {
     const char *sql[] = {
@@ -76,11 +226,14 @@ bool Database::createTables()
         "komik_id INTEGER NOT NULL,"
         "FOREIGN KEY(username) REFERENCES users(username) ON DELETE CASCADE,"
         "FOREIGN KEY(komik_id) REFERENCES komiks(id) ON DELETE CASCADE,"
-        "UNIQUE(username, komik_id));"};
+        "UNIQUE(username, komik_id));",
+
+        // Index untuk keyset pagination (ORDER BY title, id)
+        "CREATE INDEX IF NOT EXISTS idx_komiks_title_id ON komiks(title, id);"};
 
     char *errMsg = nullptr;
 
-    for (int i = 0; i < 5; i++)
+    for (size_t i = 0; i < sizeof(sql) / sizeof(sql[0]); i++)
     {
         int rc = sqlite3_exec(db, sql[i], nullptr, nullptr, &errMsg);
         if (rc != SQLITE_OK)
@@ -91,7 +244,8 @@ bool Database::createTables()
         }
     }
 
-    cout << "All tables created successfully." << endl;
+    if (verbose)
+        cout << "All tables created successfully." << endl;
     return true;
 }
 
@@ -99,104 +253,160 @@ bool Database::createTables()
 
 bool Database::insertKomik(Komik *komik)
 {
+    METRIC_TIMER("db.insertKomik");
     if (!db || !komik)
         return false;
 
+    WriteRecord record(WRITE_INSERT, "komik:" + to_string(komik->id),
+                       "INSERT INTO komiks (id, title, author, genre) VALUES (?, ?, ?, ?);",
+                       "Failed to insert komik");
+    record.bind(komik->id).bind(komik->title).bind(komik->author).bind(komik->genre);
+
+    if (!submitWrite(record))
+        return false;
+
+    if (verbose)
+        cout << "Komik inserted to database: " << komik->title << endl;
+    return true;
+}
+
+// Insert banyak komik dengan satu prepared statement (di-reset per row).
+// Transaction diatur oleh pemanggil. Return jumlah row yang berhasil, -1 kalau gagal
+int Database::insertKomiksBulk(const vector<Komik *> &komiks)
+{
+    METRIC_TIMER("db.insertKomiksBulk");
+    flushWrites();
+
+    if (!db)
+        return -1;
+
     const char *sql = "INSERT INTO komiks (id, title, author, genre) VALUES (?, ?, ?, ?);";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
     {
         cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << endl;
-        return false;
+        return -1;
     }
 
-    sqlite3_bind_int(stmt, 1, komik->id);
-    sqlite3_bind_text(stmt, 2, komik->title.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, komik->author.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 4, komik->genre.c_str(), -1, SQLITE_TRANSIENT);
+    int inserted = 0;
+    for (Komik *komik : komiks)
+    {
+        sqlite3_bind_int(stmt, 1, komik->id);
+        sqlite3_bind_text(stmt, 2, komik->title.c_str(), (int)komik->title.size(), SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 3, komik->author.c_str(), (int)komik->author.size(), SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 4, komik->genre.c_str(), (int)komik->genre.size(), SQLITE_STATIC);
 
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
 
-    if (rc != SQLITE_DONE)
-    {
-        cerr << "Failed to insert komik: " << sqlite3_errmsg(db) << endl;
-        return false;
+        if (rc != SQLITE_DONE)
+        {
+            cerr << "Failed to insert komik: " << sqlite3_errmsg(db) << endl;
+            sqlite3_finalize(stmt);
+            return -1;
+        }
+        inserted++;
     }
 
-    cout << "Komik inserted to database: " << komik->title << endl;
-    return true;
+    sqlite3_finalize(stmt);
+    return inserted;
 }
 
 bool Database::updateKomik(int id, Komik *komik)
 {
+    METRIC_TIMER("db.updateKomik");
     if (!db || !komik)
         return false;
 
-    const char *sql = "UPDATE komiks SET title = ?, author = ?, genre = ? WHERE id = ?;";
-    sqlite3_stmt *stmt;
+    WriteRecord record(WRITE_UPDATE, "komik:" + to_string(id),
+                       "UPDATE komiks SET title = ?, author = ?, genre = ? WHERE id = ?;",
+                       "Failed to update komik");
+    record.bind(komik->title).bind(komik->author).bind(komik->genre).bind(id);
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-    {
-        cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << endl;
+    if (!submitWrite(record))
         return false;
-    }
 
-    sqlite3_bind_text(stmt, 1, komik->title.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, komik->author.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, komik->genre.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 4, id);
+    if (verbose)
+        cout << "Komik updated in database: ID " << id << endl;
+    return true;
+}
 
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+bool Database::deleteKomik(int id)
+{
+    METRIC_TIMER("db.deleteKomik");
+    if (!db)
+        return false;
 
-    if (rc != SQLITE_DONE)
-    {
-        cerr << "Failed to update komik: " << sqlite3_errmsg(db) << endl;
+    WriteRecord record(WRITE_DELETE, "komik:" + to_string(id),
+                       "DELETE FROM komiks WHERE id = ?;",
+                       "Failed to delete komik");
+    record.bind(id);
+
+    if (!submitWrite(record))
         return false;
-    }
 
-    cout << "Komik updated in database: ID " << id << endl;
+    // PRAGMA foreign_keys off, jadi ON DELETE CASCADE tidak jalan: favorites
+    // komik ini dihapus manual supaya tidak ikut dihitung di popularity
+    WriteRecord favorites(WRITE_DELETE, "favs:komik:" + to_string(id),
+                          "DELETE FROM favorites WHERE komik_id = ?;",
+                          "Failed to delete komik favorites");
+    favorites.bind(id);
+
+    if (!submitWrite(favorites))
+        return false;
+
+    if (verbose)
+        cout << "Komik deleted from database: ID " << id << endl;
     return true;
 }
 
-bool Database::deleteKomik(int id)
+vector<Komik *> Database::getAllKomiks()
 {
+    METRIC_TIMER("db.getAllKomiks");
+    flushWrites();
+
+    vector<Komik *> komiks;
     if (!db)
-        return false;
+        return komiks;
 
-    const char *sql = "DELETE FROM komiks WHERE id = ?;";
+    const char *sql = "SELECT id, title, author, genre FROM komiks;";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
     {
         cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << endl;
-        return false;
+        return komiks;
     }
 
-    sqlite3_bind_int(stmt, 1, id);
-
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-
-    if (rc != SQLITE_DONE)
+    while (sqlite3_step(stmt) == SQLITE_ROW)
     {
-        cerr << "Failed to delete komik: " << sqlite3_errmsg(db) << endl;
-        return false;
+        int id = sqlite3_column_int(stmt, 0);
+        string title = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+        string author = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
+        string genre = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
+
+        Komik *k = new Komik(id, title, author, genre);
+        komiks.push_back(k);
     }
 
-    cout << "Komik deleted from database: ID " << id << endl;
-    return true;
+    sqlite3_finalize(stmt);
+    return komiks;
 }
 
-vector<Komik *> Database::getAllKomiks()
+vector<Komik *> Database::getKomiksPage(const string &afterTitle, int afterId, int limit)
 {
+    METRIC_TIMER("db.getKomiksPage");
+    flushWrites();
+
     vector<Komik *> komiks;
     if (!db)
         return komiks;
 
-    const char *sql = "SELECT id, title, author, genre FROM komiks;";
+    // Halaman pertama: afterTitle = "" dan afterId = 0 (semua title >= "")
+    const char *sql = "SELECT id, title, author, genre FROM komiks "
+                      "WHERE (title, id) > (?, ?) "
+                      "ORDER BY title, id LIMIT ?;";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
@@ -205,6 +415,10 @@ vector<Komik *> Database::getAllKomiks()
         return komiks;
     }
 
+    sqlite3_bind_text(stmt, 1, afterTitle.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 2, afterId);
+    sqlite3_bind_int(stmt, 3, limit);
+
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
         int id = sqlite3_column_int(stmt, 0);
@@ -212,16 +426,31 @@ vector<Komik *> Database::getAllKomiks()
         string author = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
         string genre = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
 
-        Komik *k = new Komik(id, title, author, genre);
-        komiks.push_back(k);
+        komiks.push_back(new Komik(id, title, author, genre));
     }
 
     sqlite3_finalize(stmt);
     return komiks;
 }
 
+int Database::countKomiks()
+{
+    METRIC_TIMER("db.countKomiks");
+    flushWrites();
+
+    int total = 0;
+    forEachRow("SELECT COUNT(*) FROM komiks;", [&total](sqlite3_stmt *stmt)
+               {
+                   total = sqlite3_column_int(stmt, 0);
+                   return false; });
+    return total;
+}
+
 Komik *Database::getKomikById(int id)
 {
+    METRIC_TIMER("db.getKomikById");
+    flushWrites();
+
     if (!db)
         return nullptr;
 
@@ -251,6 +480,9 @@ Komik *Database::getKomikById(int id)
 
 int Database::getLastKomikId()
 {
+    METRIC_TIMER("db.getLastKomikId");
+    flushWrites();
+
     if (!db)
         return 0;
 
@@ -272,10 +504,56 @@ int Database::getLastKomikId()
     return lastId;
 }
 
+// Fingerprint tabel komiks: count, max id, total byte string + file change counter
+// (header SQLite offset 24, naik setiap ada transaksi yang mengubah file)
+TableFingerprint Database::getKomiksFingerprint()
+{
+    METRIC_TIMER("db.getKomiksFingerprint");
+    flushWrites();
+
+    TableFingerprint fp;
+    if (!db)
+        return fp;
+
+    const char *sql = "SELECT COUNT(*), COALESCE(MAX(id), 0), "
+                      "COALESCE(SUM(length(CAST(title AS BLOB)) + length(CAST(author AS BLOB)) + length(CAST(genre AS BLOB))), 0) "
+                      "FROM komiks;";
+    sqlite3_stmt *stmt;
+
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        return fp;
+    }
+
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        fp.rowCount = sqlite3_column_int64(stmt, 0);
+        fp.maxId = sqlite3_column_int64(stmt, 1);
+        fp.payloadBytes = sqlite3_column_int64(stmt, 2);
+    }
+
+    sqlite3_finalize(stmt);
+
+    ifstream file(dbPath.c_str(), ios::binary);
+    unsigned char header[28];
+    if (file.read(reinterpret_cast<char *>(header), sizeof(header)))
+    {
+        fp.fileChangeCounter = ((unsigned int)header[24] << 24) |
+                               ((unsigned int)header[25] << 16) |
+                               ((unsigned int)header[26] << 8) |
+                               (unsigned int)header[27];
+    }
+
+    return fp;
+}
+
 // ===== GENRE OPERATIONS =====
 
 bool Database::insertGenre(const string &name)
 {
+    METRIC_TIMER("db.insertGenre");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -297,6 +575,9 @@ bool Database::insertGenre(const string &name)
 
 bool Database::updateGenre(const string &oldName, const string &newName)
 {
+    METRIC_TIMER("db.updateGenre");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -319,6 +600,9 @@ bool Database::updateGenre(const string &oldName, const string &newName)
 
 bool Database::deleteGenre(const string &name)
 {
+    METRIC_TIMER("db.deleteGenre");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -340,6 +624,9 @@ bool Database::deleteGenre(const string &name)
 
 vector<string> Database::getAllGenres()
 {
+    METRIC_TIMER("db.getAllGenres");
+    flushWrites();
+
     vector<string> genres;
     if (!db)
         return genres;
@@ -364,6 +651,9 @@ vector<string> Database::getAllGenres()
 
 bool Database::genreExists(const string &name)
 {
+    METRIC_TIMER("db.genreExists");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -391,6 +681,9 @@ bool Database::genreExists(const string &name)
 
 bool Database::insertAuthor(const string &name)
 {
+    METRIC_TIMER("db.insertAuthor");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -412,6 +705,9 @@ bool Database::insertAuthor(const string &name)
 
 bool Database::updateAuthor(const string &oldName, const string &newName)
 {
+    METRIC_TIMER("db.updateAuthor");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -434,6 +730,9 @@ bool Database::updateAuthor(const string &oldName, const string &newName)
 
 bool Database::deleteAuthor(const string &name)
 {
+    METRIC_TIMER("db.deleteAuthor");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -455,6 +754,9 @@ bool Database::deleteAuthor(const string &name)
 
 vector<string> Database::getAllAuthors()
 {
+    METRIC_TIMER("db.getAllAuthors");
+    flushWrites();
+
     vector<string> authors;
     if (!db)
         return authors;
@@ -479,6 +781,9 @@ vector<string> Database::getAllAuthors()
 
 bool Database::authorExists(const string &name)
 {
+    METRIC_TIMER("db.authorExists");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -506,82 +811,54 @@ bool Database::authorExists(const string &name)
 
 bool Database::insertUser(const User &user)
 {
+    METRIC_TIMER("db.insertUser");
     if (!db)
         return false;
 
-    const char *sql = "INSERT INTO users (id, username, password, role) VALUES (?, ?, ?, ?);";
-    sqlite3_stmt *stmt;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-    {
-        cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << endl;
-        return false;
-    }
-
-    sqlite3_bind_int(stmt, 1, user.id);
-    sqlite3_bind_text(stmt, 2, user.username.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, user.password.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 4, user.role.c_str(), -1, SQLITE_TRANSIENT);
-
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    WriteRecord record(WRITE_INSERT, "user:" + user.username,
+                       "INSERT INTO users (id, username, password, role) VALUES (?, ?, ?, ?);",
+                       "Failed to insert user");
+    record.bind(user.id).bind(user.username).bind(user.password).bind(user.role);
 
-    if (rc != SQLITE_DONE)
-    {
-        cerr << "Failed to insert user: " << sqlite3_errmsg(db) << endl;
+    if (!submitWrite(record))
         return false;
-    }
 
-    cout << "User inserted to database: " << user.username << endl;
+    if (verbose)
+        cout << "User inserted to database: " << user.username << endl;
     return true;
 }
 
 bool Database::updateUser(const User &user)
 {
+    METRIC_TIMER("db.updateUser");
     if (!db)
         return false;
 
-    const char *sql = "UPDATE users SET password = ?, role = ? WHERE username = ?;";
-    sqlite3_stmt *stmt;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-    {
-        return false;
-    }
-
-    sqlite3_bind_text(stmt, 1, user.password.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, user.role.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 3, user.username.c_str(), -1, SQLITE_TRANSIENT);
-
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-
-    return rc == SQLITE_DONE;
+    WriteRecord record(WRITE_UPDATE, "user:" + user.username,
+                       "UPDATE users SET password = ?, role = ? WHERE username = ?;",
+                       "Failed to update user");
+    record.bind(user.password).bind(user.role).bind(user.username);
+    return submitWrite(record);
 }
 
 bool Database::deleteUser(const string &username)
 {
+    METRIC_TIMER("db.deleteUser");
     if (!db)
         return false;
 
-    const char *sql = "DELETE FROM users WHERE username = ?;";
-    sqlite3_stmt *stmt;
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
-    {
-        return false;
-    }
-
-    sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT);
-
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-
-    return rc == SQLITE_DONE;
+    WriteRecord record(WRITE_DELETE, "user:" + username,
+                       "DELETE FROM users WHERE username = ?;",
+                       "Failed to delete user");
+    record.bind(username);
+    return submitWrite(record);
 }
 
 vector<User> Database::getAllUsers()
 {
+    METRIC_TIMER("db.getAllUsers");
+    flushWrites();
+
     vector<User> users;
     if (!db)
         return users;
@@ -611,6 +888,9 @@ vector<User> Database::getAllUsers()
 
 User *Database::getUserByUsername(const string &username)
 {
+    METRIC_TIMER("db.getUserByUsername");
+    flushWrites();
+
     if (!db)
         return nullptr;
 
@@ -641,6 +921,9 @@ User *Database::getUserByUsername(const string &username)
 
 bool Database::userExists(const string &username)
 {
+    METRIC_TIMER("db.userExists");
+    flushWrites();
+
     if (!db)
         return false;
 
@@ -666,6 +949,9 @@ bool Database::userExists(const string &username)
 
 int Database::getLastUserId()
 {
+    METRIC_TIMER("db.getLastUserId");
+    flushWrites();
+
     if (!db)
         return 0;
 
@@ -691,39 +977,68 @@ int Database::getLastUserId()
 
 bool Database::addFavorite(const string &username, int komikId)
 {
+    METRIC_TIMER("db.addFavorite");
+    if (!db)
+        return false;
+
+    WriteRecord record(WRITE_SET, "fav:" + username + "\t" + to_string(komikId),
+                       "INSERT OR IGNORE INTO favorites (username, komik_id) VALUES (?, ?);",
+                       "Failed to add favorite");
+    record.bind(username).bind(komikId);
+    return submitWrite(record);
+}
+
+bool Database::removeFavorite(const string &username, int komikId)
+{
+    METRIC_TIMER("db.removeFavorite");
     if (!db)
         return false;
 
-    const char *sql = "INSERT OR IGNORE INTO favorites (username, komik_id) VALUES (?, ?);";
+    WriteRecord record(WRITE_SET, "fav:" + username + "\t" + to_string(komikId),
+                       "DELETE FROM favorites WHERE username = ? AND komik_id = ?;",
+                       "Failed to remove favorite");
+    record.bind(username).bind(komikId);
+    return submitWrite(record);
+}
+
+vector<int> Database::getFavoritesByUser(const string &username)
+{
+    METRIC_TIMER("db.getFavoritesByUser");
+    flushWrites();
+
+    vector<int> favorites;
+    if (!db)
+        return favorites;
+
+    const char *sql = "SELECT komik_id FROM favorites WHERE username = ?;";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
     {
-        cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << endl;
-        return false;
+        return favorites;
     }
 
     sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 2, komikId);
 
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-
-    if (rc != SQLITE_DONE)
+    while (sqlite3_step(stmt) == SQLITE_ROW)
     {
-        cerr << "Failed to add favorite: " << sqlite3_errmsg(db) << endl;
-        return false;
+        int komikId = sqlite3_column_int(stmt, 0);
+        favorites.push_back(komikId);
     }
 
-    return true;
+    sqlite3_finalize(stmt);
+    return favorites;
 }
 
-bool Database::removeFavorite(const string &username, int komikId)
+bool Database::isFavorite(const string &username, int komikId)
 {
+    METRIC_TIMER("db.isFavorite");
+    flushWrites();
+
     if (!db)
         return false;
 
-    const char *sql = "DELETE FROM favorites WHERE username = ? AND komik_id = ?;";
+    const char *sql = "SELECT COUNT(*) FROM favorites WHERE username = ? AND komik_id = ?;";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
@@ -734,60 +1049,72 @@ bool Database::removeFavorite(const string &username, int komikId)
     sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(stmt, 2, komikId);
 
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    bool exists = false;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        exists = sqlite3_column_int(stmt, 0) > 0;
+    }
 
-    return rc == SQLITE_DONE;
+    sqlite3_finalize(stmt);
+    return exists;
 }
 
-vector<int> Database::getFavoritesByUser(const string &username)
+// Jumlah favorite per komik: pair (komik_id, count)
+vector<pair<int, int>> Database::getFavoriteCounts()
 {
-    vector<int> favorites;
+    METRIC_TIMER("db.getFavoriteCounts");
+    flushWrites();
+
+    vector<pair<int, int>> counts;
     if (!db)
-        return favorites;
+        return counts;
 
-    const char *sql = "SELECT komik_id FROM favorites WHERE username = ?;";
+    // Join ke komiks: favorites sisa komik yang sudah dihapus tidak dihitung
+    const char *sql = "SELECT f.komik_id, COUNT(*) FROM favorites f "
+                      "JOIN komiks k ON k.id = f.komik_id GROUP BY f.komik_id;";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
     {
-        return favorites;
+        return counts;
     }
 
-    sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT);
-
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
         int komikId = sqlite3_column_int(stmt, 0);
-        favorites.push_back(komikId);
+        int count = sqlite3_column_int(stmt, 1);
+        counts.push_back(make_pair(komikId, count));
     }
 
     sqlite3_finalize(stmt);
-    return favorites;
+    return counts;
 }
 
-bool Database::isFavorite(const string &username, int komikId)
+// Semua baris favorites: pair (username, komik_id), urut per username
+vector<pair<string, int>> Database::getAllFavorites()
 {
+    METRIC_TIMER("db.getAllFavorites");
+    flushWrites();
+
+    vector<pair<string, int>> favorites;
     if (!db)
-        return false;
+        return favorites;
 
-    const char *sql = "SELECT COUNT(*) FROM favorites WHERE username = ? AND komik_id = ?;";
+    const char *sql = "SELECT username, komik_id FROM favorites ORDER BY username;";
     sqlite3_stmt *stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
     {
-        return false;
+        return favorites;
     }
 
-    sqlite3_bind_text(stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 2, komikId);
-
-    bool exists = false;
-    if (sqlite3_step(stmt) == SQLITE_ROW)
+    while (sqlite3_step(stmt) == SQLITE_ROW)
     {
-        exists = sqlite3_column_int(stmt, 0) > 0;
+        string username = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+        int komikId = sqlite3_column_int(stmt, 1);
+        favorites.push_back(make_pair(username, komikId));
     }
 
     sqlite3_finalize(stmt);
-    return exists;
+    return favorites;
 }
\ No newline at end of file
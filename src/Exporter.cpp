@@ -0,0 +1,223 @@
+/*
+ * Exporter.cpp
+ * Streaming export CSV / JSONL dengan buffered output
+ */
+
+#include "../include/Exporter.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+Exporter::Exporter(Database &db) : db(db), bufferSize(1 << 20) {}
+
+// ===== DESTRUCTOR =====
+Exporter::~Exporter() {}
+
+void Exporter::setBufferSize(size_t bytes)
+{
+    bufferSize = bytes > 4096 ? bytes : 4096;
+}
+
+bool Exporter::parseFormat(const string &name, ExportFormat &format)
+{
+    if (name == "csv")
+        format = EXPORT_CSV;
+    else if (name == "jsonl" || name == "json")
+        format = EXPORT_JSONL;
+    else
+        return false;
+    return true;
+}
+
+// ===== CSV FIELD =====
+// Quote hanya kalau perlu (ada koma, quote, atau newline)
+void Exporter::appendCsvField(string &out, const char *text, int length)
+{
+    bool needQuote = false;
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r')
+        {
+            needQuote = true;
+            break;
+        }
+    }
+
+    if (!needQuote)
+    {
+        out.append(text, length);
+        return;
+    }
+
+    out += '"';
+    for (int i = 0; i < length; i++)
+    {
+        if (text[i] == '"')
+            out += '"';
+        out += text[i];
+    }
+    out += '"';
+}
+
+// ===== JSON STRING =====
+void Exporter::appendJsonString(string &out, const char *text, int length)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    out += '"';
+    for (int i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)text[i];
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (c < 0x20)
+            {
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+            }
+            else
+            {
+                out += (char)c;
+            }
+        }
+    }
+    out += '"';
+}
+
+// ===== EXPORT QUERY =====
+bool Exporter::exportQuery(const string &sql, const vector<string> &columns, ExportFormat format,
+                           const string &path, long &rows)
+{
+    rows = 0;
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        cerr << "Cannot open export file: " << path << endl;
+        return false;
+    }
+
+    string buffer;
+    buffer.reserve(bufferSize + 4096);
+    bool writeOk = true;
+
+    if (format == EXPORT_CSV)
+    {
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            if (i > 0)
+                buffer += ',';
+            buffer += columns[i];
+        }
+        buffer += '\n';
+    }
+
+    bool ok = db.forEachRow(sql, [&](sqlite3_stmt *stmt)
+                            {
+        if (format == EXPORT_JSONL)
+            buffer += '{';
+
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            // Cek type dulu, karena sqlite3_column_text bisa mengubah type value
+            bool isNumber = sqlite3_column_type(stmt, (int)i) == SQLITE_INTEGER;
+            const char *text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, (int)i));
+            int length = sqlite3_column_bytes(stmt, (int)i);
+
+            if (text == nullptr)
+            {
+                text = "";
+                length = 0;
+            }
+
+            if (format == EXPORT_CSV)
+            {
+                if (i > 0)
+                    buffer += ',';
+                appendCsvField(buffer, text, length);
+            }
+            else
+            {
+                if (i > 0)
+                    buffer += ',';
+                appendJsonString(buffer, columns[i].c_str(), (int)columns[i].size());
+                buffer += ':';
+                if (isNumber)
+                    buffer.append(text, length);
+                else
+                    appendJsonString(buffer, text, length);
+            }
+        }
+
+        if (format == EXPORT_JSONL)
+            buffer += '}';
+        buffer += '\n';
+        rows++;
+
+        // Flush hanya kalau buffer sudah penuh
+        if (buffer.size() >= bufferSize)
+        {
+            writeOk = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+        return writeOk; });
+
+    if (writeOk && !buffer.empty())
+    {
+        writeOk = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    }
+
+    if (fclose(file) != 0)
+        writeOk = false;
+
+    if (!writeOk)
+    {
+        cerr << "Failed to write export file: " << path << endl;
+    }
+
+    return ok && writeOk;
+}
+
+// ===== EXPORT TABLE =====
+bool Exporter::exportTable(const string &table, ExportFormat format, const string &path, long &rows)
+{
+    if (table == "komiks")
+    {
+        return exportQuery("SELECT id, title, author, genre FROM komiks ORDER BY id;",
+                           {"id", "title", "author", "genre"}, format, path, rows);
+    }
+    if (table == "users")
+    {
+        // Password hash sengaja tidak di-export
+        return exportQuery("SELECT id, username, role FROM users ORDER BY id;",
+                           {"id", "username", "role"}, format, path, rows);
+    }
+    if (table == "favorites")
+    {
+        return exportQuery("SELECT id, username, komik_id FROM favorites ORDER BY id;",
+                           {"id", "username", "komik_id"}, format, path, rows);
+    }
+
+    cerr << "Unknown table: " << table << " (use komiks, users, or favorites)" << endl;
+    return false;
+}
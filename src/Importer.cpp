@@ -0,0 +1,507 @@
+/*
+ * Importer.cpp
+ * Bulk importer CSV / JSONL dengan parsing paralel dan single-transaction insert
+ */
+
+#include "../include/Importer.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <set>
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+Importer::Importer(BST &tree, KomikManager &manager, Database &db)
+    : tree(tree), manager(manager), db(db), strict(false)
+{
+    threadCount = (int)thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 2;
+}
+
+// ===== DESTRUCTOR =====
+Importer::~Importer() {}
+
+void Importer::setThreads(int count)
+{
+    threadCount = count > 0 ? count : 1;
+}
+
+void Importer::setStrict(bool enabled)
+{
+    strict = enabled;
+}
+
+// ===== PARSE CSV =====
+// Field boleh di-quote ("..."), quote di dalam field ditulis "" (RFC 4180, satu baris per record)
+bool Importer::parseCsvLine(const string &line, vector<string> &fields)
+{
+    fields.clear();
+    string field;
+    bool quoted = false;
+    size_t i = 0;
+
+    while (i <= line.size())
+    {
+        char c = i < line.size() ? line[i] : ',';
+
+        if (quoted)
+        {
+            if (i == line.size())
+                return false; // quote tidak ditutup
+
+            if (c == '"')
+            {
+                if (i + 1 < line.size() && line[i + 1] == '"')
+                {
+                    field += '"';
+                    i++;
+                }
+                else
+                {
+                    quoted = false;
+                }
+            }
+            else
+            {
+                field += c;
+            }
+        }
+        else if (c == '"' && field.find_first_not_of(' ') == string::npos)
+        {
+            field.clear();
+            quoted = true;
+        }
+        else if (c == ',')
+        {
+            size_t first = field.find_first_not_of(' ');
+            size_t last = field.find_last_not_of(' ');
+            fields.push_back(first == string::npos ? "" : field.substr(first, last - first + 1));
+            field.clear();
+        }
+        else
+        {
+            field += c;
+        }
+
+        i++;
+    }
+
+    return true;
+}
+
+// ===== PARSE JSON STRING =====
+// pos menunjuk ke '"' pembuka, setelah selesai pos ada di setelah '"' penutup
+bool Importer::readJsonString(const string &line, size_t &pos, string &value)
+{
+    value.clear();
+    pos++;
+
+    while (pos < line.size())
+    {
+        char c = line[pos++];
+
+        if (c == '"')
+            return true;
+
+        if (c != '\\')
+        {
+            value += c;
+            continue;
+        }
+
+        if (pos >= line.size())
+            return false;
+
+        char esc = line[pos++];
+        switch (esc)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            value += esc;
+            break;
+        case 'n':
+            value += '\n';
+            break;
+        case 't':
+            value += '\t';
+            break;
+        case 'r':
+            value += '\r';
+            break;
+        case 'b':
+            value += '\b';
+            break;
+        case 'f':
+            value += '\f';
+            break;
+        case 'u':
+        {
+            if (pos + 4 > line.size())
+                return false;
+
+            unsigned int code = (unsigned int)strtoul(line.substr(pos, 4).c_str(), nullptr, 16);
+            pos += 4;
+
+            // Encode ke UTF-8 (surrogate pair tidak didukung, cukup BMP)
+            if (code < 0x80)
+            {
+                value += (char)code;
+            }
+            else if (code < 0x800)
+            {
+                value += (char)(0xC0 | (code >> 6));
+                value += (char)(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                value += (char)(0xE0 | (code >> 12));
+                value += (char)(0x80 | ((code >> 6) & 0x3F));
+                value += (char)(0x80 | (code & 0x3F));
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+// ===== PARSE JSONL =====
+// Hanya object datar dengan value string; hasil fields = {title, author, genre}
+bool Importer::parseJsonLine(const string &line, vector<string> &fields)
+{
+    fields.assign(3, "");
+    bool found[3] = {false, false, false};
+
+    size_t pos = line.find_first_not_of(" \t");
+    if (pos == string::npos || line[pos] != '{')
+        return false;
+    pos++;
+
+    while (true)
+    {
+        pos = line.find_first_not_of(" \t", pos);
+        if (pos == string::npos)
+            return false;
+
+        if (line[pos] == '}')
+            break;
+
+        if (line[pos] != '"')
+            return false;
+
+        string key, value;
+        if (!readJsonString(line, pos, key))
+            return false;
+
+        pos = line.find_first_not_of(" \t", pos);
+        if (pos == string::npos || line[pos] != ':')
+            return false;
+
+        pos = line.find_first_not_of(" \t", pos + 1);
+        if (pos == string::npos || line[pos] != '"')
+            return false;
+
+        if (!readJsonString(line, pos, value))
+            return false;
+
+        int index = key == "title" ? 0 : key == "author" ? 1 : key == "genre" ? 2 : -1;
+        if (index >= 0)
+        {
+            fields[index] = value;
+            found[index] = true;
+        }
+
+        pos = line.find_first_not_of(" \t", pos);
+        if (pos == string::npos)
+            return false;
+
+        if (line[pos] == ',')
+            pos++;
+        else if (line[pos] != '}')
+            return false;
+    }
+
+    return found[0] && found[1] && found[2];
+}
+
+// "Action;horror , Drama" -> "Action, horror, Drama" (+ daftar nama genre)
+string Importer::normalizeGenres(const string &genreList, vector<string> &names)
+{
+    names.clear();
+    string token;
+
+    for (size_t i = 0; i <= genreList.size(); i++)
+    {
+        char c = i < genreList.size() ? genreList[i] : ',';
+        if (c == ',' || c == ';')
+        {
+            size_t first = token.find_first_not_of(' ');
+            size_t last = token.find_last_not_of(' ');
+            if (first != string::npos)
+            {
+                string name = token.substr(first, last - first + 1);
+                if (find(names.begin(), names.end(), name) == names.end())
+                    names.push_back(name);
+            }
+            token.clear();
+        }
+        else
+        {
+            token += c;
+        }
+    }
+
+    string result;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        result += names[i];
+        if (i < names.size() - 1)
+            result += ", ";
+    }
+    return result;
+}
+
+// ===== PARSE CHUNK (dijalankan di worker thread) =====
+void Importer::parseChunk(const string &data, size_t begin, size_t end, long firstLine,
+                          bool json, vector<ImportRow> &rows, vector<string> &errors)
+{
+    vector<string> fields;
+    long lineNumber = firstLine;
+    size_t pos = begin;
+
+    while (pos < end)
+    {
+        size_t newline = data.find('\n', pos);
+        if (newline == string::npos || newline > end)
+            newline = end;
+
+        string line = data.substr(pos, newline - pos);
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+
+        pos = newline + 1;
+
+        if (line.find_first_not_of(" \t") == string::npos)
+        {
+            lineNumber++;
+            continue;
+        }
+
+        bool ok = json ? parseJsonLine(line, fields) : parseCsvLine(line, fields);
+
+        // Header CSV boleh ada di baris pertama file
+        if (!json && lineNumber == 1 && ok && fields.size() == 3 && fields[0] == "title")
+        {
+            lineNumber++;
+            continue;
+        }
+
+        if (!ok || fields.size() != 3 || fields[0].empty() || fields[1].empty() || fields[2].empty())
+        {
+            errors.push_back("line " + to_string(lineNumber) + ": invalid record");
+        }
+        else
+        {
+            ImportRow row;
+            row.line = lineNumber;
+            row.title = fields[0];
+            row.author = fields[1];
+            row.genre = fields[2];
+            rows.push_back(row);
+        }
+
+        lineNumber++;
+    }
+}
+
+// ===== IMPORT FILE =====
+bool Importer::importFile(const string &path, ImportReport &report)
+{
+    report = ImportReport();
+
+    ifstream file(path.c_str(), ios::binary);
+    if (!file)
+    {
+        cerr << "Cannot open import file: " << path << endl;
+        return false;
+    }
+
+    stringstream buffer;
+    buffer << file.rdbuf();
+    string data = buffer.str();
+
+    string lowerPath = path;
+    transform(lowerPath.begin(), lowerPath.end(), lowerPath.begin(), ::tolower);
+    bool json = lowerPath.size() >= 6 && (lowerPath.compare(lowerPath.size() - 6, 6, ".jsonl") == 0 ||
+                                          lowerPath.compare(lowerPath.size() - 5, 5, ".json") == 0);
+
+    // ===== 1. PARSE PARALEL =====
+    auto parseStart = chrono::steady_clock::now();
+
+    int workers = (int)min<size_t>((size_t)threadCount, data.size() / (64 * 1024) + 1);
+    vector<size_t> bounds(1, 0);
+    vector<long> firstLines(1, 1);
+
+    // Potong data di batas baris, sekaligus hitung nomor baris awal tiap potongan
+    for (int w = 1; w < workers; w++)
+    {
+        size_t target = data.size() * w / workers;
+        size_t cut = data.find('\n', max(target, bounds.back()));
+        if (cut == string::npos)
+            break;
+
+        long lines = firstLines.back() + (long)count(data.begin() + bounds.back(), data.begin() + cut + 1, '\n');
+        bounds.push_back(cut + 1);
+        firstLines.push_back(lines);
+    }
+    bounds.push_back(data.size());
+
+    size_t chunks = bounds.size() - 1;
+    vector<vector<ImportRow>> chunkRows(chunks);
+    vector<vector<string>> chunkErrors(chunks);
+    vector<thread> pool;
+
+    for (size_t c = 1; c < chunks; c++)
+    {
+        pool.push_back(thread(parseChunk, cref(data), bounds[c], bounds[c + 1], firstLines[c],
+                              json, ref(chunkRows[c]), ref(chunkErrors[c])));
+    }
+    parseChunk(data, bounds[0], bounds[1], firstLines[0], json, chunkRows[0], chunkErrors[0]);
+
+    for (thread &t : pool)
+        t.join();
+
+    report.parseMs = chrono::duration<double, milli>(chrono::steady_clock::now() - parseStart).count();
+
+    // ===== 2. VALIDASI =====
+    auto insertStart = chrono::steady_clock::now();
+
+    vector<string> authorList = manager.getAllAuthors();
+    vector<string> genreList = manager.getAllGenres();
+    set<string> knownAuthors(authorList.begin(), authorList.end());
+    set<string> knownGenres(genreList.begin(), genreList.end());
+    vector<string> newAuthors, newGenres;
+
+    vector<Komik *> komiks;
+    set<Komik *, bool (*)(Komik *, Komik *)> seen([](Komik *a, Komik *b)
+                                                 { return *a < *b; });
+
+    for (size_t c = 0; c < chunks; c++)
+    {
+        report.errors.insert(report.errors.end(), chunkErrors[c].begin(), chunkErrors[c].end());
+        report.rowsRead += chunkRows[c].size() + chunkErrors[c].size();
+        report.rejected += chunkErrors[c].size();
+
+        for (const ImportRow &row : chunkRows[c])
+        {
+            vector<string> names;
+            string genre = normalizeGenres(row.genre, names);
+
+            string error;
+            if (names.empty())
+            {
+                error = "genre cannot be empty";
+            }
+            else if (strict && !knownAuthors.count(row.author))
+            {
+                error = "unknown author '" + row.author + "'";
+            }
+            else if (strict)
+            {
+                for (const string &name : names)
+                {
+                    if (!knownGenres.count(name))
+                    {
+                        error = "unknown genre '" + name + "'";
+                        break;
+                    }
+                }
+            }
+
+            if (!error.empty())
+            {
+                report.rejected++;
+                report.errors.push_back("line " + to_string(row.line) + ": " + error);
+                continue;
+            }
+
+            Komik *komik = new Komik(0, row.title, row.author, genre);
+
+            // Duplikat (sudah ada di tree atau muncul dua kali di file) dilewati
+            if (tree.find(*komik) != nullptr || seen.count(komik))
+            {
+                report.duplicates++;
+                delete komik;
+                continue;
+            }
+
+            if (!knownAuthors.count(row.author))
+            {
+                knownAuthors.insert(row.author);
+                newAuthors.push_back(row.author);
+            }
+            for (const string &name : names)
+            {
+                if (!knownGenres.count(name))
+                {
+                    knownGenres.insert(name);
+                    newGenres.push_back(name);
+                }
+            }
+
+            komik->id = manager.getNextId();
+            seen.insert(komik);
+            komiks.push_back(komik);
+        }
+    }
+
+    // ===== 3. INSERT (SATU TRANSACTION) =====
+    if (!db.beginTransaction())
+    {
+        for (Komik *k : komiks)
+            delete k;
+        return false;
+    }
+
+    bool ok = true;
+    for (const string &name : newAuthors)
+        ok = ok && db.insertAuthor(name);
+    for (const string &name : newGenres)
+        ok = ok && db.insertGenre(name);
+
+    int inserted = ok ? db.insertKomiksBulk(komiks) : -1;
+
+    if (inserted < 0 || !db.commitTransaction())
+    {
+        db.rollbackTransaction();
+        cerr << "Import failed, transaction rolled back." << endl;
+        for (Komik *k : komiks)
+            delete k;
+        return false;
+    }
+
+    report.imported = inserted;
+    report.newAuthors = newAuthors.size();
+    report.newGenres = newGenres.size();
+    report.insertMs = chrono::duration<double, milli>(chrono::steady_clock::now() - insertStart).count();
+
+    // Refresh list author/genre di manager
+    manager.getAllAuthors();
+    manager.getAllGenres();
+
+    // ===== 4. BULK BUILD TREE =====
+    auto buildStart = chrono::steady_clock::now();
+    tree.bulkInsert(komiks);
+    report.buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - buildStart).count();
+
+    return true;
+}
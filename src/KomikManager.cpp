@@ -5,13 +5,15 @@
 
 #include "../include/KomikManager.h"
 #include "../include/Database.h"
+#include "../include/MemoryReport.h"
 #include <iostream>
 #include <algorithm>
+#include <bitset>
 
 using namespace std;
 
 // ===== CONSTRUCTOR =====
-KomikManager::KomikManager(Database *database) : db(database)
+KomikManager::KomikManager(Database *database) : db(database), verbose(true), recommenderLoaded(false)
 {
     if (db)
     {
@@ -35,6 +37,9 @@ KomikManager::KomikManager(Database *database) : db(database)
 
         // Load Authors dari database
         authors = db->getAllAuthors();
+
+        // Load jumlah favorite per komik (co-occurrence di-build saat dibutuhkan)
+        loadFavoriteCounts();
     }
     else
     {
@@ -52,7 +57,25 @@ void KomikManager::loadDataFromDB(BST &tree)
     for (Komik *k : data)
         tree.insert(k);
 
-    cout << "Loaded " << data.size() << " comics from database." << endl;
+    if (verbose)
+        cout << "Loaded " << data.size() << " comics from database." << endl;
+}
+
+// ===== RELOAD FROM DB =====
+void KomikManager::reloadFromDB(BST &tree)
+{
+    if (!db)
+        return;
+
+    tree.clear();
+    nextId = db->getLastKomikId() + 1;
+    genres = db->getAllGenres();
+    authors = db->getAllAuthors();
+    loadFavoriteCounts();
+    favoritesCache.clear();
+    recommender.clear();
+    recommenderLoaded = false;
+    loadDataFromDB(tree);
 }
 
 // ===== GET NEXT ID =====
@@ -85,7 +108,8 @@ void KomikManager::addGenre(const string &name)
     if (db && db->insertGenre(name))
     {
         genres.push_back(name);
-        cout << "Genre '" << name << "' added successfully!" << endl;
+        if (verbose)
+            cout << "Genre '" << name << "' added successfully!" << endl;
     }
     else
     {
@@ -135,7 +159,8 @@ void KomikManager::updateGenre(const string &oldName, const string &newName, BST
             }
         }
 
-        cout << "Genre updated successfully!" << endl;
+        if (verbose)
+            cout << "Genre updated successfully!" << endl;
     }
     else
     {
@@ -156,7 +181,8 @@ void KomikManager::deleteGenre(const string &name)
     if (db && db->deleteGenre(name))
     {
         genres.erase(it);
-        cout << "Genre '" << name << "' deleted successfully!" << endl;
+        if (verbose)
+            cout << "Genre '" << name << "' deleted successfully!" << endl;
     }
     else
     {
@@ -186,7 +212,8 @@ void KomikManager::addAuthor(const string &name)
     if (db && db->insertAuthor(name))
     {
         authors.push_back(name);
-        cout << "Author '" << name << "' added successfully!" << endl;
+        if (verbose)
+            cout << "Author '" << name << "' added successfully!" << endl;
     }
     else
     {
@@ -224,7 +251,8 @@ void KomikManager::updateAuthor(const string &oldName, const string &newName, BS
             }
         }
 
-        cout << "Author updated successfully!" << endl;
+        if (verbose)
+            cout << "Author updated successfully!" << endl;
     }
     else
     {
@@ -244,7 +272,8 @@ void KomikManager::deleteAuthor(const string &name)
     if (db && db->deleteAuthor(name))
     {
         authors.erase(it);
-        cout << "Author '" << name << "' deleted successfully!" << endl;
+        if (verbose)
+            cout << "Author '" << name << "' deleted successfully!" << endl;
     }
     else
     {
@@ -254,55 +283,324 @@ void KomikManager::deleteAuthor(const string &name)
 
 // ===== FAVORITES OPERATIONS =====
 
-void KomikManager::addFavorite(const string &username, int comicId)
+// Ambil set favorites user dari cache, load dari database kalau belum ada
+set<int> &KomikManager::getFavoriteSet(const string &username)
+{
+    auto it = favoritesCache.find(username);
+    if (it != favoritesCache.end())
+    {
+        return it->second;
+    }
+
+    set<int> &favorites = favoritesCache[username];
+    if (db)
+    {
+        vector<int> ids = db->getFavoritesByUser(username);
+        favorites.insert(ids.begin(), ids.end());
+    }
+    return favorites;
+}
+
+bool KomikManager::addFavorite(const string &username, int comicId)
 {
     if (!db)
     {
         cerr << "Database not available!" << endl;
-        return;
+        return false;
     }
 
-    // Check if already favorite
-    if (db->isFavorite(username, comicId))
+    set<int> &favorites = getFavoriteSet(username);
+
+    // Check if already favorite (dari cache, tanpa query)
+    if (favorites.count(comicId))
     {
-        cout << "Komik already in favorites!" << endl;
-        return;
+        if (verbose)
+            cout << "Komik already in favorites!" << endl;
+        return true;
     }
 
-    // Add to database
+    // Add to database, lalu update cache
     if (db->addFavorite(username, comicId))
     {
-        cout << "Komik added to favorites!" << endl;
-    }
-    else
-    {
-        cerr << "Failed to add to favorites!" << endl;
+        if (recommenderLoaded)
+            recommender.onFavoriteAdded(favorites, comicId);
+        favorites.insert(comicId);
+        adjustFavoriteCount(comicId, 1);
+        if (verbose)
+            cout << "Komik added to favorites!" << endl;
+        return true;
     }
+
+    cerr << "Failed to add to favorites!" << endl;
+    return false;
 }
 
-void KomikManager::removeFavorite(const string &username, int comicId)
+bool KomikManager::removeFavorite(const string &username, int comicId)
 {
     if (!db)
     {
         cerr << "Database not available!" << endl;
-        return;
+        return false;
     }
 
+    set<int> &favorites = getFavoriteSet(username);
+
     if (db->removeFavorite(username, comicId))
     {
-        cout << "Komik removed from favorites!" << endl;
-    }
-    else
-    {
-        cerr << "Failed to remove from favorites!" << endl;
+        if (favorites.erase(comicId))
+        {
+            if (recommenderLoaded)
+                recommender.onFavoriteRemoved(favorites, comicId);
+            adjustFavoriteCount(comicId, -1);
+        }
+        if (verbose)
+            cout << "Komik removed from favorites!" << endl;
+        return true;
     }
+
+    cerr << "Failed to remove from favorites!" << endl;
+    return false;
 }
 
 vector<int> KomikManager::getFavoritesByUser(const string &username)
 {
     if (db)
     {
-        return db->getFavoritesByUser(username);
+        const set<int> &favorites = getFavoriteSet(username);
+        return vector<int>(favorites.begin(), favorites.end());
     }
     return vector<int>();
-}
\ No newline at end of file
+}
+
+bool KomikManager::isFavorite(const string &username, int comicId)
+{
+    if (!db)
+        return false;
+
+    return getFavoriteSet(username).count(comicId) > 0;
+}
+
+// Buang cache user (misal setelah user dihapus), nanti di-load ulang kalau dipakai.
+// Co-count user itu ikut basi, jadi recommender di-build ulang saat dibutuhkan.
+void KomikManager::invalidateFavorites(const string &username)
+{
+    favoritesCache.erase(username);
+    recommender.clear();
+    recommenderLoaded = false;
+}
+
+// Dipanggil setelah komik dihapus dari tree. Row favorites di database ikut
+// dihapus oleh Database::deleteKomik; co-count recommender di-build ulang
+// saat dibutuhkan.
+void KomikManager::forgetKomik(int comicId)
+{
+    auto it = favoriteCounts.find(comicId);
+    if (it != favoriteCounts.end())
+    {
+        popularityRank.erase(make_pair(-it->second, comicId));
+        favoriteCounts.erase(it);
+    }
+
+    for (auto &entry : favoritesCache)
+    {
+        entry.second.erase(comicId);
+    }
+
+    recommender.clear();
+    recommenderLoaded = false;
+}
+
+// ===== POPULARITY OPERATIONS =====
+
+void KomikManager::loadFavoriteCounts()
+{
+    favoriteCounts.clear();
+    popularityRank.clear();
+
+    vector<pair<int, int>> counts = db->getFavoriteCounts();
+    for (const auto &entry : counts)
+    {
+        favoriteCounts[entry.first] = entry.second;
+        popularityRank.insert(make_pair(-entry.second, entry.first));
+    }
+}
+
+// Update counter + posisi di ranking (hapus entry lama, insert entry baru)
+void KomikManager::adjustFavoriteCount(int comicId, int delta)
+{
+    int &count = favoriteCounts[comicId];
+
+    if (count > 0)
+    {
+        popularityRank.erase(make_pair(-count, comicId));
+    }
+
+    count += delta;
+
+    if (count > 0)
+    {
+        popularityRank.insert(make_pair(-count, comicId));
+    }
+    else
+    {
+        favoriteCounts.erase(comicId);
+    }
+}
+
+int KomikManager::getFavoriteCount(int comicId) const
+{
+    auto it = favoriteCounts.find(comicId);
+    return it != favoriteCounts.end() ? it->second : 0;
+}
+
+// Top-N komik paling banyak difavoritkan: pair (komikId, count)
+vector<pair<int, int>> KomikManager::getTopFavorited(int n) const
+{
+    vector<pair<int, int>> top;
+
+    for (auto it = popularityRank.begin(); it != popularityRank.end() && (int)top.size() < n; ++it)
+    {
+        top.push_back(make_pair(it->second, -it->first));
+    }
+
+    return top;
+}
+
+// ===== RECOMMENDATION OPERATIONS =====
+
+// Load semua favorites sekali: isi cache per user + build co-occurrence matrix
+void KomikManager::loadAllFavorites()
+{
+    favoritesCache.clear();
+    recommender.clear();
+
+    vector<pair<string, int>> rows = db->getAllFavorites();
+    for (const auto &row : rows)
+    {
+        set<int> &favorites = favoritesCache[row.first];
+        if (favorites.count(row.second))
+            continue;
+
+        recommender.onFavoriteAdded(favorites, row.second);
+        favorites.insert(row.second);
+    }
+
+    recommenderLoaded = true;
+}
+
+// Bitset genre: bit ke-i = genres[i] (maksimal 64 genre pertama)
+unsigned long long KomikManager::genreMask(const string &genreList) const
+{
+    unsigned long long mask = 0;
+    size_t start = 0;
+
+    while (start < genreList.size())
+    {
+        size_t end = genreList.find(',', start);
+        if (end == string::npos)
+            end = genreList.size();
+
+        size_t first = genreList.find_first_not_of(' ', start);
+        size_t last = genreList.find_last_not_of(' ', end - 1);
+
+        if (first != string::npos && first < end && last >= first)
+        {
+            string name = genreList.substr(first, last - first + 1);
+            for (size_t i = 0; i < genres.size() && i < 64; i++)
+            {
+                if (genres[i] == name)
+                {
+                    mask |= 1ULL << i;
+                    break;
+                }
+            }
+        }
+
+        start = end + 1;
+    }
+
+    return mask;
+}
+
+// Top-k komik yang paling sering difavoritkan bersama comicId
+// Urutan: shared fans -> shared genres -> popularity -> id
+vector<Recommendation> KomikManager::getSimilarKomiks(int comicId, int k, BST &tree)
+{
+    vector<Recommendation> results;
+
+    if (!recommenderLoaded && db)
+        loadAllFavorites();
+
+    vector<pair<int, int>> candidates = recommender.getCoFavorites(comicId);
+
+    if (candidates.empty() || k <= 0)
+        return results;
+
+    // Ambil genre komik target + kandidat dalam satu traversal
+    unordered_map<int, unsigned long long> masks;
+    masks[comicId] = 0;
+    for (const auto &c : candidates)
+    {
+        masks[c.first] = 0;
+    }
+
+    tree.inOrder([&masks, this](Komik *comic)
+                 {
+        auto it = masks.find(comic->id);
+        if (it != masks.end()) {
+            it->second = genreMask(comic->genre);
+        } });
+
+    unsigned long long targetMask = masks[comicId];
+
+    for (const auto &c : candidates)
+    {
+        Recommendation rec;
+        rec.comicId = c.first;
+        rec.sharedFans = c.second;
+        rec.sharedGenres = (int)bitset<64>(masks[c.first] & targetMask).count();
+        results.push_back(rec);
+    }
+
+    size_t top = min((size_t)k, results.size());
+    partial_sort(results.begin(), results.begin() + top, results.end(), [this](const Recommendation &a, const Recommendation &b)
+         {
+        if (a.sharedFans != b.sharedFans) return a.sharedFans > b.sharedFans;
+        if (a.sharedGenres != b.sharedGenres) return a.sharedGenres > b.sharedGenres;
+        int popA = getFavoriteCount(a.comicId);
+        int popB = getFavoriteCount(b.comicId);
+        if (popA != popB) return popA > popB;
+        return a.comicId < b.comicId; });
+
+    results.resize(top);
+
+    return results;
+}
+
+// ===== MEMORY =====
+void KomikManager::accountMemory(MemoryReport &report) const
+{
+    size_t listBytes = MemoryReport::vectorBytes(genres) + MemoryReport::vectorBytes(authors);
+    for (const string &name : genres)
+        listBytes += report.stringBytes(name);
+    for (const string &name : authors)
+        listBytes += report.stringBytes(name);
+    report.add("Genre/author lists", genres.size() + authors.size(), listBytes);
+
+    size_t cacheEntries = 0;
+    size_t cacheBytes = favoritesCache.size() * MemoryReport::mapNodeBytes(favoritesCache);
+    for (const auto &entry : favoritesCache)
+    {
+        cacheBytes += report.stringBytes(entry.first);
+        cacheBytes += entry.second.size() * MemoryReport::setNodeBytes(entry.second);
+        cacheEntries += entry.second.size();
+    }
+    report.add("Favorites cache (user -> set)", cacheEntries, cacheBytes);
+
+    report.add("Favorite counts (map)", favoriteCounts.size(),
+               favoriteCounts.size() * MemoryReport::mapNodeBytes(favoriteCounts));
+    report.add("Popularity rank (set)", popularityRank.size(),
+               popularityRank.size() * MemoryReport::setNodeBytes(popularityRank));
+
+    recommender.accountMemory(report);
+}
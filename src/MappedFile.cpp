@@ -0,0 +1,126 @@
+/*
+ * MappedFile.cpp
+ * Wrapper memory-mapped file read-only (Windows & POSIX)
+ */
+
+#include "../include/MappedFile.h"
+
+// ===== PLATFORM-SPECIFIC INCLUDES =====
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+#ifdef _WIN32
+MappedFile::MappedFile() : data(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : data(nullptr), length(0), fd(-1) {}
+#endif
+
+// ===== DESTRUCTOR =====
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const string &path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const char *>(view);
+    length = (size_t)fileSize.QuadPart;
+#else
+    int handle = ::open(path.c_str(), O_RDONLY);
+    if (handle < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(handle, &st) != 0 || st.st_size == 0)
+    {
+        ::close(handle);
+        return false;
+    }
+
+    void *view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, handle, 0);
+    if (view == MAP_FAILED)
+    {
+        ::close(handle);
+        return false;
+    }
+
+    fd = handle;
+    data = static_cast<const char *>(view);
+    length = (size_t)st.st_size;
+#endif
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle((HANDLE)mappingHandle);
+    CloseHandle((HANDLE)fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<char *>(data), length);
+    ::close(fd);
+    fd = -1;
+#endif
+
+    data = nullptr;
+    length = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return data != nullptr;
+}
@@ -16,6 +16,11 @@ extern void crudGenreMenu(KomikManager &manager, BST &tree);
 extern void crudAuthorMenu(KomikManager &manager, BST &tree);
 extern void traversalMenu(BST &tree);
 extern void viewFavoritesMenu(KomikManager &manager, BST &tree);
+extern void browseKomikPages(BST &tree, const string &title);
+extern void databaseInspectorMenu(Database &db, BST &tree, KomikManager &manager, Auth &auth);
+
+// Koneksi database global (didefinisikan di main.cpp)
+extern Database dbConnection;
 
 // ===== CONSTRUCTOR =====
 MenuSystem::MenuSystem(BST &tree, KomikManager &manager, Auth &auth)
@@ -204,6 +209,8 @@ void MenuSystem::showAdminMenu()
         cout << "5. View All Favorites\n";
         cout << "6. User Management\n";
         cout << "7. System Statistics\n";
+        cout << "8. Most Favorited Comics\n";
+        cout << "9. Database Inspector\n";
         cout << "0. Logout\n";
         cout << "\nChoice: ";
 
@@ -245,6 +252,12 @@ void MenuSystem::showAdminMenu()
             cout << "Total Authors: " << manager.getAllAuthors().size() << endl;
             pause();
             break;
+        case 8:
+            topFavoritesMenu();
+            break;
+        case 9:
+            databaseInspectorMenu(dbConnection, tree, manager, auth);
+            break;
         case 0:
             auth.logout();
             cout << "\n\033[32mLogged out successfully!\033[0m" << endl;
@@ -274,6 +287,7 @@ void MenuSystem::showUserMenu()
         cout << "1. Browse All Comics\n";
         cout << "2. Search & Filter Comics\n";
         cout << "3. My Favorites\n";
+        cout << "4. Recommendations (Similar Comics)\n";
         cout << "0. Logout\n";
         cout << "\nChoice: ";
 
@@ -351,6 +365,9 @@ void MenuSystem::showUserMenu()
         case 3:
             myFavoritesMenu();
             break;
+        case 4:
+            recommendationsMenu();
+            break;
         case 0:
             auth.logout();
             cout << "\n\033[32mLogged out successfully!\033[0m" << endl;
@@ -417,7 +434,10 @@ void MenuSystem::userManagementMenu()
             cout << "Enter username to delete: ";
             getline(cin, username);
 
-            auth.deleteUser(username);
+            if (auth.deleteUser(username))
+            {
+                manager.invalidateFavorites(username);
+            }
             pause();
             break;
         }
@@ -439,33 +459,132 @@ void MenuSystem::userManagementMenu()
     } while (choice != 0);
 }
 
-// ===== VIEW COMICS MENU =====
-void MenuSystem::viewComicsMenu()
+// ===== TOP FAVORITES MENU =====
+void MenuSystem::topFavoritesMenu()
 {
-    printHeader("BROWSE ALL COMICS");
+    printHeader("MOST FAVORITED COMICS");
 
-    if (tree.isEmpty())
+    int n;
+    cout << "How many comics to show? ";
+    cin >> n;
+
+    if (cin.fail() || n <= 0)
     {
-        cout << "\033[33mNo comics available!\033[0m" << endl;
+        cin.clear();
+        n = 10;
     }
-    else
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    vector<pair<int, int>> top = manager.getTopFavorited(n);
+
+    if (top.empty())
     {
-        cout << left << setw(5) << "ID"
-             << setw(30) << "Title"
-             << setw(25) << "Author"
-             << setw(20) << "Genre(s)" << endl;
-        cout << string(80, '-') << endl;
-
-        tree.inOrder([](Komik *comic)
-                     { cout << left << setw(5) << comic->id
-                            << setw(30) << comic->title
-                            << setw(25) << comic->author
-                            << setw(20) << comic->genre << endl; });
+        cout << "\033[33mNo favorites yet!\033[0m" << endl;
+        pause();
+        return;
+    }
+
+    // Cari title untuk komik yang masuk top-N (satu kali traversal)
+    map<int, string> titles;
+    for (const auto &entry : top)
+    {
+        titles[entry.first] = "Unknown";
+    }
+
+    tree.inOrder([&titles](Komik *comic)
+                 {
+        auto it = titles.find(comic->id);
+        if (it != titles.end()) {
+            it->second = comic->title;
+        } });
+
+    cout << left << setw(6) << "Rank"
+         << setw(10) << "Komik ID"
+         << setw(35) << "Title"
+         << setw(12) << "Favorites" << endl;
+    cout << string(63, '-') << endl;
+
+    for (size_t i = 0; i < top.size(); i++)
+    {
+        cout << left << setw(6) << (i + 1)
+             << setw(10) << top[i].first
+             << setw(35) << titles[top[i].first]
+             << setw(12) << top[i].second << endl;
     }
 
     pause();
 }
 
+// ===== RECOMMENDATIONS MENU =====
+void MenuSystem::recommendationsMenu()
+{
+    printHeader("RECOMMENDATIONS");
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    string keyword;
+    cout << "Enter keyword to find comic: ";
+    getline(cin, keyword);
+
+    Komik *comic = tree.findByKeyword(keyword);
+    if (comic == nullptr)
+    {
+        pause();
+        return;
+    }
+
+    vector<Recommendation> similar = manager.getSimilarKomiks(comic->id, 5, tree);
+
+    if (similar.empty())
+    {
+        cout << "\033[33mBelum ada data favorites untuk komik ini.\033[0m" << endl;
+        pause();
+        return;
+    }
+
+    cout << "\033[1;36mPeople who liked '" << comic->title << "' also liked:\033[0m\n"
+         << endl;
+
+    cout << left << setw(5) << "ID"
+         << setw(30) << "Title"
+         << setw(15) << "Shared Fans"
+         << setw(15) << "Shared Genres" << endl;
+    cout << string(65, '-') << endl;
+
+    // Cari title untuk semua rekomendasi (satu kali traversal)
+    map<int, string> titles;
+    for (const Recommendation &rec : similar)
+    {
+        titles[rec.comicId] = "Unknown";
+    }
+
+    tree.inOrder([&titles](Komik *c)
+                 {
+        auto it = titles.find(c->id);
+        if (it != titles.end()) {
+            it->second = c->title;
+        } });
+
+    for (const Recommendation &rec : similar)
+    {
+        cout << left << setw(5) << rec.comicId
+             << setw(30) << titles[rec.comicId]
+             << setw(15) << rec.sharedFans
+             << setw(15) << rec.sharedGenres << endl;
+    }
+
+    pause();
+}
+
+// ===== VIEW COMICS MENU =====
+void MenuSystem::viewComicsMenu()
+{
+    // Buang newline sisa input menu sebelumnya
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    browseKomikPages(tree, "BROWSE ALL COMICS");
+}
+
 // ===== MY FAVORITES MENU =====
 void MenuSystem::myFavoritesMenu()
 {
@@ -0,0 +1,166 @@
+/*
+ * Metrics.cpp
+ * Registry timer / counter / histogram untuk instrumentasi hot path
+ */
+
+#include "../include/Metrics.h"
+#include <algorithm>
+
+using namespace std;
+
+// ===== METRIC SLOT =====
+MetricSlot::MetricSlot(const string &name) : name(name), count(0), totalNs(0), maxNs(0)
+{
+    for (int i = 0; i < METRIC_BUCKETS; i++)
+        buckets[i].store(0, memory_order_relaxed);
+}
+
+void MetricSlot::record(unsigned long long ns)
+{
+    count.fetch_add(1, memory_order_relaxed);
+    totalNs.fetch_add(ns, memory_order_relaxed);
+    buckets[Metrics::bucketIndex(ns)].fetch_add(1, memory_order_relaxed);
+
+    unsigned long long previous = maxNs.load(memory_order_relaxed);
+    while (ns > previous && !maxNs.compare_exchange_weak(previous, ns, memory_order_relaxed))
+    {
+    }
+}
+
+void MetricSlot::reset()
+{
+    count.store(0, memory_order_relaxed);
+    totalNs.store(0, memory_order_relaxed);
+    maxNs.store(0, memory_order_relaxed);
+    for (int i = 0; i < METRIC_BUCKETS; i++)
+        buckets[i].store(0, memory_order_relaxed);
+}
+
+// ===== REGISTRY =====
+Metrics::Metrics()
+{
+}
+
+Metrics::~Metrics()
+{
+    // Slot sengaja tidak di-delete: static lokal di call site bisa masih
+    // menunjuk ke slot saat static destructor lain berjalan
+}
+
+Metrics &Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+bool Metrics::enabled()
+{
+#ifndef KOMIK_NO_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+MetricSlot *Metrics::slot(const string &name)
+{
+    lock_guard<mutex> lock(registryMutex);
+    for (MetricSlot *existing : slots)
+    {
+        if (existing->name == name)
+            return existing;
+    }
+
+    MetricSlot *created = new MetricSlot(name);
+    slots.push_back(created);
+    return created;
+}
+
+// ===== HISTOGRAM BUCKET =====
+// 0..7 ns: satu bucket per nilai. Di atasnya: bucket = (pangkat 2, 2 bit
+// berikutnya), jadi setiap rentang [2^e, 2^(e+1)) dibagi 4.
+int Metrics::bucketIndex(unsigned long long ns)
+{
+    if (ns < 8)
+        return (int)ns;
+
+    int exponent = 0;
+    for (unsigned long long v = ns; v > 1; v >>= 1)
+        exponent++;
+
+    int sub = (int)((ns >> (exponent - 2)) & 3);
+    return 8 + (exponent - 3) * 4 + sub;
+}
+
+// Nilai tengah bucket (dipakai untuk estimasi percentile)
+double Metrics::bucketValue(int index)
+{
+    if (index < 8)
+        return index;
+
+    int exponent = (index - 8) / 4 + 3;
+    int sub = (index - 8) % 4;
+    double lower = (double)(4 + sub) * (double)(1ULL << (exponent - 2));
+    double width = (double)(1ULL << (exponent - 2));
+    return lower + width / 2;
+}
+
+static double percentileOf(const unsigned long long *buckets, unsigned long long total, double p)
+{
+    if (total == 0)
+        return 0;
+
+    unsigned long long target = (unsigned long long)(p * (total - 1)) + 1;
+    unsigned long long seen = 0;
+    for (int i = 0; i < METRIC_BUCKETS; i++)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+            return Metrics::bucketValue(i);
+    }
+    return Metrics::bucketValue(METRIC_BUCKETS - 1);
+}
+
+vector<MetricSnapshot> Metrics::snapshot()
+{
+    vector<MetricSnapshot> result;
+    lock_guard<mutex> lock(registryMutex);
+
+    for (MetricSlot *slot : slots)
+    {
+        MetricSnapshot snap;
+        snap.name = slot->name;
+        snap.count = slot->count.load(memory_order_relaxed);
+        snap.totalNs = slot->totalNs.load(memory_order_relaxed);
+        snap.maxNs = slot->maxNs.load(memory_order_relaxed);
+        if (snap.count == 0)
+            continue;
+
+        // Salinan bucket: recording bisa jalan terus selama snapshot
+        unsigned long long copy[METRIC_BUCKETS];
+        unsigned long long timedCount = 0;
+        for (int i = 0; i < METRIC_BUCKETS; i++)
+        {
+            copy[i] = slot->buckets[i].load(memory_order_relaxed);
+            timedCount += copy[i];
+        }
+
+        snap.timed = timedCount > 0;
+        // Nilai tengah bucket bisa melewati max yang sebenarnya
+        snap.p50Ns = min(percentileOf(copy, timedCount, 0.50), (double)snap.maxNs);
+        snap.p95Ns = min(percentileOf(copy, timedCount, 0.95), (double)snap.maxNs);
+        snap.p99Ns = min(percentileOf(copy, timedCount, 0.99), (double)snap.maxNs);
+        result.push_back(snap);
+    }
+
+    sort(result.begin(), result.end(), [](const MetricSnapshot &a, const MetricSnapshot &b)
+         { return a.name < b.name; });
+    return result;
+}
+
+void Metrics::reset()
+{
+    lock_guard<mutex> lock(registryMutex);
+    for (MetricSlot *slot : slots)
+        slot->reset();
+}
@@ -0,0 +1,246 @@
+/*
+ * PersistentBST.cpp
+ * Copy-on-write (path copying) BST dengan snapshot untuk reader tanpa lock
+ */
+
+#include "../include/PersistentBST.h"
+#include "../include/TextMatch.h"
+#include <atomic>
+#include <cctype>
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+PersistentBST::PersistentBST() : current(make_shared<const Version>()) {}
+
+// ===== SNAPSHOT =====
+PersistentBST::Version PersistentBST::snapshot() const
+{
+    return *atomic_load(&current);
+}
+
+PersistentNodePtr PersistentBST::currentRoot() const
+{
+    return atomic_load(&current)->getRoot();
+}
+
+void PersistentBST::publish(const PersistentNodePtr &newRoot)
+{
+    // Dipanggil dengan writerMutex terkunci, jadi nomor versi tidak balapan
+    unsigned long long next = atomic_load(&current)->getNumber() + 1;
+    atomic_store(&current, make_shared<const Version>(newRoot, next));
+}
+
+// ===== INSERT =====
+// Hanya node di jalur pencarian yang disalin, subtree lain dipakai bersama
+PersistentNodePtr PersistentBST::insertHelper(const PersistentNodePtr &node, const Komik &komik)
+{
+    if (!node)
+        return make_shared<const PersistentNode>(komik, nullptr, nullptr);
+
+    if (komik < node->komik)
+        return make_shared<const PersistentNode>(node->komik, insertHelper(node->left, komik), node->right);
+
+    if (komik > node->komik)
+        return make_shared<const PersistentNode>(node->komik, node->left, insertHelper(node->right, komik));
+
+    // Key sama (title, author, genre): update id seperti BST::insert
+    return make_shared<const PersistentNode>(komik, node->left, node->right);
+}
+
+void PersistentBST::insert(const Komik &komik)
+{
+    lock_guard<mutex> guard(writerMutex);
+    publish(insertHelper(currentRoot(), komik));
+}
+
+// ===== REMOVE =====
+PersistentNodePtr PersistentBST::removeMin(const PersistentNodePtr &node, Komik &minKomik)
+{
+    if (!node->left)
+    {
+        minKomik = Komik(node->komik.id, node->komik.title, node->komik.author, node->komik.genre);
+        return node->right;
+    }
+    return make_shared<const PersistentNode>(node->komik, removeMin(node->left, minKomik), node->right);
+}
+
+// Navigasi pakai title saja, sama seperti BST::deleteHelper
+PersistentNodePtr PersistentBST::removeHelper(const PersistentNodePtr &node, const string &title, bool &removed)
+{
+    if (!node)
+        return node;
+
+    if (title < node->komik.title)
+    {
+        PersistentNodePtr left = removeHelper(node->left, title, removed);
+        return removed ? make_shared<const PersistentNode>(node->komik, left, node->right) : node;
+    }
+
+    if (title > node->komik.title)
+    {
+        PersistentNodePtr right = removeHelper(node->right, title, removed);
+        return removed ? make_shared<const PersistentNode>(node->komik, node->left, right) : node;
+    }
+
+    removed = true;
+    if (!node->left)
+        return node->right;
+    if (!node->right)
+        return node->left;
+
+    // Dua anak: ganti dengan successor (node terkecil di right subtree)
+    Komik successor;
+    PersistentNodePtr right = removeMin(node->right, successor);
+    return make_shared<const PersistentNode>(successor, node->left, right);
+}
+
+bool PersistentBST::remove(const string &title)
+{
+    lock_guard<mutex> guard(writerMutex);
+    bool removed = false;
+    PersistentNodePtr newRoot = removeHelper(currentRoot(), title, removed);
+    if (removed)
+        publish(newRoot);
+    return removed;
+}
+
+// ===== UPDATE =====
+// Remove + insert di atas root yang sama, lalu publish SEKALI:
+// reader tidak pernah melihat keadaan setengah jalan (komik hilang)
+bool PersistentBST::update(const string &oldTitle, const Komik &updated)
+{
+    lock_guard<mutex> guard(writerMutex);
+    bool removed = false;
+    PersistentNodePtr newRoot = removeHelper(currentRoot(), oldTitle, removed);
+    if (!removed)
+        return false;
+
+    publish(insertHelper(newRoot, updated));
+    return true;
+}
+
+// ===== BULK LOAD =====
+PersistentNodePtr PersistentBST::buildBalanced(const vector<Komik *> &komiks, int low, int high)
+{
+    if (low > high)
+        return PersistentNodePtr();
+
+    int mid = low + (high - low) / 2;
+    PersistentNodePtr left = buildBalanced(komiks, low, mid - 1);
+    PersistentNodePtr right = buildBalanced(komiks, mid + 1, high);
+    return make_shared<const PersistentNode>(*komiks[mid], left, right);
+}
+
+void PersistentBST::loadFrom(const BST &tree)
+{
+    // getAllKomiks sudah in-order, jadi hasilnya tree seimbang
+    vector<Komik *> komiks = tree.getAllKomiks();
+    PersistentNodePtr newRoot = buildBalanced(komiks, 0, (int)komiks.size() - 1);
+
+    lock_guard<mutex> guard(writerMutex);
+    publish(newRoot);
+}
+
+void PersistentBST::clear()
+{
+    lock_guard<mutex> guard(writerMutex);
+    publish(PersistentNodePtr());
+}
+
+// ===== VERSION (READ ONLY) =====
+
+bool PersistentBST::Version::search(const string &title, Komik &result) const
+{
+    const PersistentNode *node = root.get();
+    while (node != nullptr)
+    {
+        if (title == node->komik.title)
+        {
+            result = Komik(node->komik.id, node->komik.title, node->komik.author, node->komik.genre);
+            return true;
+        }
+        node = title < node->komik.title ? node->left.get() : node->right.get();
+    }
+    return false;
+}
+
+void PersistentBST::Version::inOrder(const function<void(const Komik &)> &callback) const
+{
+    // Iteratif; node tetap hidup selama Version ini memegang root
+    vector<const PersistentNode *> stack;
+    const PersistentNode *node = root.get();
+
+    while (node != nullptr || !stack.empty())
+    {
+        while (node != nullptr)
+        {
+            stack.push_back(node);
+            node = node->left.get();
+        }
+
+        node = stack.back();
+        stack.pop_back();
+        callback(node->komik);
+        node = node->right.get();
+    }
+}
+
+vector<Komik> PersistentBST::Version::getAllKomiks() const
+{
+    vector<Komik> results;
+    results.reserve(count());
+    inOrder([&results](const Komik &komik)
+            { results.push_back(Komik(komik.id, komik.title, komik.author, komik.genre)); });
+    return results;
+}
+
+vector<Komik> PersistentBST::Version::searchPartial(const string &keyword) const
+{
+    string lowerKeyword = keyword;
+    for (char &c : lowerKeyword)
+        c = tolower(c);
+
+    vector<Komik> results;
+    inOrder([&](const Komik &komik)
+            {
+        if (containsLowered(komik.title, lowerKeyword))
+            results.push_back(Komik(komik.id, komik.title, komik.author, komik.genre)); });
+    return results;
+}
+
+vector<Komik> PersistentBST::Version::collectAfter(const Komik *after, size_t limit) const
+{
+    vector<Komik> page;
+    vector<const PersistentNode *> stack;
+    const PersistentNode *node = root.get();
+
+    while (node != nullptr)
+    {
+        if (after == nullptr || *after < node->komik)
+        {
+            stack.push_back(node);
+            node = node->left.get();
+        }
+        else
+        {
+            node = node->right.get();
+        }
+    }
+
+    while (!stack.empty() && page.size() < limit)
+    {
+        node = stack.back();
+        stack.pop_back();
+        page.push_back(Komik(node->komik.id, node->komik.title, node->komik.author, node->komik.genre));
+
+        node = node->right.get();
+        while (node != nullptr)
+        {
+            stack.push_back(node);
+            node = node->left.get();
+        }
+    }
+
+    return page;
+}
@@ -0,0 +1,148 @@
+/*
+ * QueryRunner.cpp
+ * Read-only ad-hoc SQL dengan streaming row, row cap, dan time limit
+ */
+
+#include "../include/QueryRunner.h"
+#include <iostream>
+#include <cctype>
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+QueryRunner::QueryRunner() : db(nullptr), timeLimitMs(5000) {}
+
+// ===== DESTRUCTOR =====
+QueryRunner::~QueryRunner()
+{
+    close();
+}
+
+bool QueryRunner::open(const string &path)
+{
+    close();
+
+    // Koneksi sendiri, read-only: query analis tidak bisa mengubah data
+    // dan tidak berbagi state transaksi dengan koneksi utama
+    int rc = sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr);
+    if (rc != SQLITE_OK)
+    {
+        cerr << "Cannot open read-only connection: " << sqlite3_errmsg(db) << endl;
+        sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+
+    // Cek deadline setiap ~1000 instruksi VDBE
+    sqlite3_progress_handler(db, 1000, &QueryRunner::progressCallback, this);
+    return true;
+}
+
+void QueryRunner::close()
+{
+    if (db)
+    {
+        sqlite3_close(db);
+        db = nullptr;
+    }
+}
+
+bool QueryRunner::isOpen() const
+{
+    return db != nullptr;
+}
+
+// Return non-zero = SQLite menghentikan statement dengan SQLITE_INTERRUPT
+int QueryRunner::progressCallback(void *self)
+{
+    QueryRunner *runner = static_cast<QueryRunner *>(self);
+    return chrono::steady_clock::now() > runner->deadline ? 1 : 0;
+}
+
+static double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+bool QueryRunner::run(const string &sql, long maxRows,
+                      const function<void(const vector<string> &)> &onColumns,
+                      const function<void(sqlite3_stmt *)> &onRow,
+                      QueryStats &stats)
+{
+    stats = QueryStats();
+    if (!db)
+        return false;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    deadline = start + chrono::milliseconds(timeLimitMs);
+
+    sqlite3_stmt *stmt = nullptr;
+    const char *tail = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, &tail) != SQLITE_OK)
+    {
+        cerr << "Failed to prepare query: " << sqlite3_errmsg(db) << endl;
+        return false;
+    }
+    stats.prepareMs = elapsedMs(start);
+
+    if (!stmt)
+    {
+        cerr << "Query is empty." << endl;
+        return false;
+    }
+
+    // Hanya satu statement per eksekusi (sisa setelah ';' harus kosong)
+    while (tail && *tail && (isspace((unsigned char)*tail) || *tail == ';'))
+        tail++;
+    if (tail && *tail)
+    {
+        cerr << "Only one statement per query is allowed." << endl;
+        sqlite3_finalize(stmt);
+        return false;
+    }
+
+    if (!sqlite3_stmt_readonly(stmt))
+    {
+        cerr << "Only read-only statements are allowed." << endl;
+        sqlite3_finalize(stmt);
+        return false;
+    }
+
+    int columnCount = sqlite3_column_count(stmt);
+    vector<string> columns;
+    columns.reserve(columnCount);
+    for (int i = 0; i < columnCount; i++)
+    {
+        const char *name = sqlite3_column_name(stmt, i);
+        columns.push_back(name ? name : "");
+    }
+    onColumns(columns);
+
+    chrono::steady_clock::time_point stepStart = chrono::steady_clock::now();
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        if (stats.rows >= maxRows)
+        {
+            stats.truncated = true;
+            break;
+        }
+        onRow(stmt);
+        stats.rows++;
+    }
+    stats.stepMs = elapsedMs(stepStart);
+
+    bool ok = true;
+    if (rc == SQLITE_INTERRUPT)
+    {
+        stats.timedOut = true;
+    }
+    else if (rc != SQLITE_ROW && rc != SQLITE_DONE)
+    {
+        cerr << "Query failed: " << sqlite3_errmsg(db) << endl;
+        ok = false;
+    }
+
+    sqlite3_finalize(stmt);
+    return ok;
+}
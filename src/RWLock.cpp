@@ -0,0 +1,54 @@
+/*
+ * RWLock.cpp
+ * Reader/writer lock (writer-preferring) dari mutex + condition_variable
+ */
+
+#include "../include/RWLock.h"
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+RWLock::RWLock() : activeReaders(0), waitingWriters(0), writerActive(false) {}
+
+void RWLock::lockShared()
+{
+    unique_lock<mutex> guard(m);
+    // Reader baru menunggu kalau ada writer aktif atau sedang antre
+    readersCv.wait(guard, [this]
+                   { return !writerActive && waitingWriters == 0; });
+    activeReaders++;
+}
+
+void RWLock::unlockShared()
+{
+    unique_lock<mutex> guard(m);
+    activeReaders--;
+    if (activeReaders == 0 && waitingWriters > 0)
+    {
+        guard.unlock();
+        writersCv.notify_one();
+    }
+}
+
+void RWLock::lock()
+{
+    unique_lock<mutex> guard(m);
+    waitingWriters++;
+    writersCv.wait(guard, [this]
+                   { return !writerActive && activeReaders == 0; });
+    waitingWriters--;
+    writerActive = true;
+}
+
+void RWLock::unlock()
+{
+    unique_lock<mutex> guard(m);
+    writerActive = false;
+    bool writersPending = waitingWriters > 0;
+    guard.unlock();
+
+    if (writersPending)
+        writersCv.notify_one();
+    else
+        readersCv.notify_all();
+}
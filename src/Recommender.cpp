@@ -0,0 +1,98 @@
+/*
+ * Recommender.cpp
+ * Sparse co-occurrence matrix untuk "people who liked this also liked"
+ */
+
+#include "../include/Recommender.h"
+#include "../include/MemoryReport.h"
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+Recommender::Recommender() {}
+
+// ===== DESTRUCTOR =====
+Recommender::~Recommender() {}
+
+void Recommender::clear()
+{
+    coCounts.clear();
+}
+
+void Recommender::accountMemory(MemoryReport &report) const
+{
+    size_t pairs = 0;
+    size_t bytes = MemoryReport::unorderedBytes(coCounts);
+    for (const auto &row : coCounts)
+    {
+        pairs += row.second.size();
+        bytes += MemoryReport::unorderedBytes(row.second);
+    }
+    report.add("Recommender co-counts", pairs, bytes);
+}
+
+// Update pasangan (a, b) di kedua arah, buang entry yang jadi 0 supaya tetap sparse
+void Recommender::link(int a, int b, int delta)
+{
+    int &ab = coCounts[a][b];
+    ab += delta;
+    if (ab <= 0)
+    {
+        coCounts[a].erase(b);
+        if (coCounts[a].empty())
+            coCounts.erase(a);
+    }
+
+    int &ba = coCounts[b][a];
+    ba += delta;
+    if (ba <= 0)
+    {
+        coCounts[b].erase(a);
+        if (coCounts[b].empty())
+            coCounts.erase(b);
+    }
+}
+
+void Recommender::onFavoriteAdded(const set<int> &userFavorites, int comicId)
+{
+    for (int other : userFavorites)
+    {
+        if (other != comicId)
+            link(comicId, other, 1);
+    }
+}
+
+void Recommender::onFavoriteRemoved(const set<int> &userFavorites, int comicId)
+{
+    for (int other : userFavorites)
+    {
+        if (other != comicId)
+            link(comicId, other, -1);
+    }
+}
+
+vector<pair<int, int>> Recommender::getCoFavorites(int comicId) const
+{
+    vector<pair<int, int>> result;
+
+    auto it = coCounts.find(comicId);
+    if (it == coCounts.end())
+        return result;
+
+    result.reserve(it->second.size());
+    for (const auto &entry : it->second)
+    {
+        result.push_back(entry);
+    }
+    return result;
+}
+
+int Recommender::getCoCount(int a, int b) const
+{
+    auto it = coCounts.find(a);
+    if (it == coCounts.end())
+        return 0;
+
+    auto jt = it->second.find(b);
+    return jt != it->second.end() ? jt->second : 0;
+}
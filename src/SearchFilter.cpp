@@ -1,22 +1,102 @@
 #include "../include/SearchFilter.h"
+#include "../include/TableRenderer.h"
+#include "../include/Metrics.h"
+#include "../include/TextMatch.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 
 // ===== CONSTRUCTOR =====
 SearchFilter::SearchFilter()
+    : threadCount(0), parallelThreshold(20000), poolTask(nullptr), poolTaskCount(0), poolPending(0),
+      poolGeneration(0), poolStopping(false)
 {
-    // No initialization needed
 }
 
 // ===== DESTRUCTOR =====
 SearchFilter::~SearchFilter()
 {
-    // No cleanup needed
+    stopPool();
+}
+
+void SearchFilter::setParallelism(unsigned threads, size_t threshold)
+{
+    lock_guard<mutex> guard(scanMutex);
+    threadCount = threads;
+    parallelThreshold = threshold;
+
+    // Ukuran pool berubah: dibuat ulang saat scan paralel berikutnya
+    if (!workers.empty() && workers.size() + 1 != threads)
+        stopPool();
+}
+
+// ===== WORKER POOL =====
+void SearchFilter::startPool(unsigned threads)
+{
+    poolStopping = false;
+    for (unsigned i = 1; i < threads; i++)
+        workers.push_back(thread(&SearchFilter::poolWorker, this, i));
+}
+
+void SearchFilter::stopPool()
+{
+    {
+        lock_guard<mutex> guard(poolMutex);
+        poolStopping = true;
+    }
+    poolCv.notify_all();
+    for (thread &worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+void SearchFilter::poolWorker(unsigned index)
+{
+    unsigned long long seen = 0;
+    unique_lock<mutex> guard(poolMutex);
+
+    while (true)
+    {
+        poolCv.wait(guard, [this, seen]
+                    { return poolStopping || poolGeneration != seen; });
+        if (poolStopping)
+            return;
+        seen = poolGeneration;
+        if (index >= poolTaskCount)
+            continue;
+
+        const function<void(unsigned)> *task = poolTask;
+        guard.unlock();
+        (*task)(index);
+        guard.lock();
+
+        if (--poolPending == 0)
+            poolDoneCv.notify_all();
+    }
+}
+
+void SearchFilter::runOnPool(unsigned tasks, const function<void(unsigned)> &task)
+{
+    {
+        lock_guard<mutex> guard(poolMutex);
+        poolTask = &task;
+        poolTaskCount = tasks;
+        poolPending = tasks - 1;
+        poolGeneration++;
+    }
+    poolCv.notify_all();
+
+    task(0);
+
+    unique_lock<mutex> guard(poolMutex);
+    poolDoneCv.wait(guard, [this]
+                    { return poolPending == 0; });
+    poolTask = nullptr;
 }
 
 // ===== HELPER: TO LOWERCASE =====
@@ -27,14 +107,6 @@ string SearchFilter::toLowerCase(const string &str)
     return result;
 }
 
-// ===== HELPER: CONTAINS IGNORE CASE =====
-bool SearchFilter::containsIgnoreCase(const string &str1, const string &str2)
-{
-    string lower1 = toLowerCase(str1);
-    string lower2 = toLowerCase(str2);
-    return lower1.find(lower2) != string::npos;
-}
-
 vector<string> splitString(const string &s, char delimiter)
 {
     vector<string> tokens;
@@ -54,114 +126,126 @@ vector<string> splitString(const string &s, char delimiter)
     return tokens;
 }
 
-// ===== HELPER: DFS SEARCH =====
-void SearchFilter::dfsSearchHelper(Komik *node, const string &title, vector<Komik *> &results)
+// ===== HELPER: PARALLEL SCAN =====
+vector<Komik *> SearchFilter::scanTree(BST &tree, const function<bool(const Komik *)> &match)
 {
-    if (node == nullptr)
-        return;
+    vector<Komik *> results;
 
-    // Check current node
-    if (containsIgnoreCase(node->title, title))
+    // Serial: traversal in-order langsung, hasil otomatis urut title
+    unsigned threads = threadCount > 0 ? threadCount : thread::hardware_concurrency();
+    if (threads <= 1 || (size_t)tree.count() < parallelThreshold)
     {
-        results.push_back(node);
+        tree.inOrder([&results, &match](Komik *comic)
+                     {
+            if (match(comic))
+                results.push_back(comic); });
+        return results;
     }
 
-    // Search left subtree
-    dfsSearchHelper(node->left, title, results);
+    lock_guard<mutex> scanGuard(scanMutex);
+    if (workers.empty())
+        startPool(threads);
+    threads = workers.size() + 1;
 
-    // Search right subtree
-    dfsSearchHelper(node->right, title, results);
+    // In-order = urut title, jadi hasil scan per chunk tinggal disambung
+    vector<Komik *> komiks = tree.getAllKomiks();
+    size_t chunkSize = (komiks.size() + threads - 1) / threads;
+    vector<vector<Komik *>> partial(threads);
+
+    // Tiap task hanya menulis ke vector miliknya sendiri
+    function<void(unsigned)> scanChunk = [&komiks, &partial, &match, chunkSize](unsigned t)
+    {
+        size_t begin = t * chunkSize;
+        size_t end = min(komiks.size(), begin + chunkSize);
+        for (size_t i = begin; i < end; i++)
+        {
+            if (match(komiks[i]))
+                partial[t].push_back(komiks[i]);
+        }
+    };
+    runOnPool(threads, scanChunk);
+
+    size_t total = 0;
+    for (const vector<Komik *> &chunk : partial)
+        total += chunk.size();
+    results.reserve(total);
+    for (const vector<Komik *> &chunk : partial)
+        results.insert(results.end(), chunk.begin(), chunk.end());
+
+    return results;
 }
 
-// ===== SEARCH BY TITLE (DFS) =====
+// ===== SEARCH BY TITLE =====
 vector<Komik *> SearchFilter::searchByTitle(BST &tree, const string &title)
 {
-    vector<Komik *> results;
-
+    METRIC_TIMER("search.title");
     if (title.empty())
     {
         cout << "\033[31mError: Title cannot be empty!\033[0m" << endl;
-        return results;
+        return vector<Komik *>();
     }
 
-    // Use DFS to search
-    dfsSearchHelper(tree.getRoot(), title, results);
-
-    return results;
+    // Keyword di-lowercase sekali, bukan per node
+    string keyword = toLowerCase(title);
+    return scanTree(tree, [&keyword](const Komik *comic)
+                    { return containsLowered(comic->title.data(), comic->title.size(), keyword); });
 }
 
 // ===== SEARCH BY AUTHOR =====
 vector<Komik *> SearchFilter::searchByAuthor(BST &tree, const string &author)
 {
-    vector<Komik *> results;
-
+    METRIC_TIMER("search.author");
     if (author.empty())
     {
         cout << "\033[31mError: Author name cannot be empty!\033[0m" << endl;
-        return results;
+        return vector<Komik *>();
     }
 
-    // Get all komiks using in-order traversal
-    tree.inOrder([&results, &author, this](Komik *comic)
-                 {
-        if (containsIgnoreCase(comic->author, author)) {
-            results.push_back(comic);
-        } });
-
-    return results;
+    string keyword = toLowerCase(author);
+    return scanTree(tree, [&keyword](const Komik *comic)
+                    { return containsLowered(comic->author.data(), comic->author.size(), keyword); });
 }
 
 // ===== SEARCH BY GENRE =====
 vector<Komik *> SearchFilter::searchByGenre(BST &tree, const string &genreInput)
 {
-    vector<Komik *> results;
-
+    METRIC_TIMER("search.genre");
     if (genreInput.empty())
     {
         cout << "\033[31mError: Genre cannot be empty!\033[0m" << endl;
-        return results;
+        return vector<Komik *>();
     }
 
     // 1. Pecah input user menjadi list genre
     // Contoh: User pilih "Action, Horror" -> jadi vector {"Action", "Horror"}
     vector<string> searchTags = splitString(genreInput, ',');
+    for (string &tag : searchTags)
+    {
+        tag = toLowerCase(tag);
+    }
 
-    tree.inOrder([&](Komik *comic)
-                 {
-        bool matchAll = true; // Anggap match dulu
-
-        // 2. Cek apakah Komik ini memiliki SEMUA genre yang dicari
+    // 2. Komik harus memiliki SEMUA genre yang dicari
+    return scanTree(tree, [&searchTags](const Komik *comic)
+                    {
         for (const string &tag : searchTags) {
-            // Jika ada SATU saja genre yang tidak dimiliki komik ini, maka gagal
-            if (!containsIgnoreCase(comic->genre, tag)) {
-                matchAll = false;
-                break;
+            if (!containsLowered(comic->genre.data(), comic->genre.size(), tag)) {
+                return false;
             }
         }
-
-        // 3. Jika lolos semua kriteria, masukkan ke result
-        if (matchAll) {
-            results.push_back(comic);
-        } });
-
-    return results;
+        return true; });
 }
 
 // ===== FILTER BY GENRE (Exact Match) =====
 vector<Komik *> SearchFilter::filterByGenre(BST &tree, const string &genre)
 {
+    METRIC_TIMER("search.filterGenre");
     vector<Komik *> results;
+    string lowerGenre = toLowerCase(genre);
 
-    tree.inOrder([&results, &genre](Komik *comic)
+    tree.inOrder([&results, &lowerGenre](Komik *comic)
                  {
-        // Exact match (case-insensitive)
-        string lowerGenre = "";
-        string lowerComicGenre = "";
-        
-        for (char c : genre) lowerGenre += tolower(c);
-        for (char c : comic->genre) lowerComicGenre += tolower(c);
-        
-        if (lowerComicGenre == lowerGenre) {
+        // Exact match (case-insensitive), tanpa copy genre komik
+        if (equalsLowered(comic->genre, lowerGenre)) {
             results.push_back(comic);
         } });
 
@@ -171,18 +255,14 @@ vector<Komik *> SearchFilter::filterByGenre(BST &tree, const string &genre)
 // ===== FILTER BY AUTHOR (Exact Match) =====
 vector<Komik *> SearchFilter::filterByAuthor(BST &tree, const string &author)
 {
+    METRIC_TIMER("search.filterAuthor");
     vector<Komik *> results;
+    string lowerAuthor = toLowerCase(author);
 
-    tree.inOrder([&results, &author](Komik *comic)
+    tree.inOrder([&results, &lowerAuthor](Komik *comic)
                  {
-        // Exact match (case-insensitive)
-        string lowerAuthor = "";
-        string lowerComicAuthor = "";
-        
-        for (char c : author) lowerAuthor += tolower(c);
-        for (char c : comic->author) lowerComicAuthor += tolower(c);
-        
-        if (lowerComicAuthor == lowerAuthor) {
+        // Exact match (case-insensitive), tanpa copy author komik
+        if (equalsLowered(comic->author, lowerAuthor)) {
             results.push_back(comic);
         } });
 
@@ -192,56 +272,177 @@ vector<Komik *> SearchFilter::filterByAuthor(BST &tree, const string &author)
 // ===== FILTER BY MULTIPLE (Genre AND Author) =====
 vector<Komik *> SearchFilter::filterByMultiple(BST &tree, const string &genre, const string &author)
 {
-    vector<Komik *> results;
+    METRIC_TIMER("search.multi");
+    string genreKeyword = toLowerCase(genre);
+    string authorKeyword = toLowerCase(author);
+
+    return scanTree(tree, [&genreKeyword, &authorKeyword](const Komik *comic)
+                    {
+        bool genreMatch = genreKeyword.empty() || containsLowered(comic->genre.data(), comic->genre.size(), genreKeyword);
+        bool authorMatch = authorKeyword.empty() || containsLowered(comic->author.data(), comic->author.size(), authorKeyword);
+        return genreMatch && authorMatch; });
+}
 
-    tree.inOrder([&results, &genre, &author, this](Komik *comic)
-                 {
-        bool genreMatch = genre.empty() || containsIgnoreCase(comic->genre, genre);
-        bool authorMatch = author.empty() || containsIgnoreCase(comic->author, author);
-        
-        if (genreMatch && authorMatch) {
-            results.push_back(comic);
-        } });
+// ===== CATALOG IMAGE (READ-ONLY) =====
+
+vector<size_t> SearchFilter::scanCatalog(const CatalogImage &image, const function<bool(const CatalogEntry &)> &match)
+{
+    vector<size_t> results;
+    CatalogEntry entry;
+
+    // Record di katalog sudah urut in-order, jadi hasil otomatis urut title
+    for (size_t i = 0; i < image.size(); i++)
+    {
+        if (image.getEntry(i, entry) && match(entry))
+        {
+            results.push_back(i);
+        }
+    }
 
     return results;
 }
 
+vector<size_t> SearchFilter::searchByTitle(const CatalogImage &image, const string &title)
+{
+    METRIC_TIMER("catalog.search.title");
+    if (title.empty())
+    {
+        cout << "\033[31mError: Title cannot be empty!\033[0m" << endl;
+        return vector<size_t>();
+    }
+
+    string keyword = toLowerCase(title);
+    return scanCatalog(image, [&keyword](const CatalogEntry &e)
+                       { return containsLowered(e.title, e.titleLength, keyword); });
+}
+
+vector<size_t> SearchFilter::searchByAuthor(const CatalogImage &image, const string &author)
+{
+    METRIC_TIMER("catalog.search.author");
+    if (author.empty())
+    {
+        cout << "\033[31mError: Author name cannot be empty!\033[0m" << endl;
+        return vector<size_t>();
+    }
+
+    string keyword = toLowerCase(author);
+    return scanCatalog(image, [&keyword](const CatalogEntry &e)
+                       { return containsLowered(e.author, e.authorLength, keyword); });
+}
+
+vector<size_t> SearchFilter::searchByGenre(const CatalogImage &image, const string &genreInput)
+{
+    METRIC_TIMER("catalog.search.genre");
+    if (genreInput.empty())
+    {
+        cout << "\033[31mError: Genre cannot be empty!\033[0m" << endl;
+        return vector<size_t>();
+    }
+
+    // Sama seperti versi BST: komik harus punya SEMUA genre yang dicari
+    vector<string> searchTags = splitString(genreInput, ',');
+    for (string &tag : searchTags)
+    {
+        tag = toLowerCase(tag);
+    }
+
+    return scanCatalog(image, [&searchTags](const CatalogEntry &e)
+                       {
+        for (const string &tag : searchTags) {
+            if (!containsLowered(e.genre, e.genreLength, tag)) {
+                return false;
+            }
+        }
+        return true; });
+}
+
+vector<size_t> SearchFilter::filterByMultiple(const CatalogImage &image, const string &genre, const string &author)
+{
+    METRIC_TIMER("catalog.search.multi");
+    string lowerGenre = toLowerCase(genre);
+    string lowerAuthor = toLowerCase(author);
+
+    return scanCatalog(image, [&lowerGenre, &lowerAuthor](const CatalogEntry &e)
+                       {
+        bool genreMatch = lowerGenre.empty() || containsLowered(e.genre, e.genreLength, lowerGenre);
+        bool authorMatch = lowerAuthor.empty() || containsLowered(e.author, e.authorLength, lowerAuthor);
+        return genreMatch && authorMatch; });
+}
+
 // ===== DISPLAY RESULTS =====
 void SearchFilter::displayResults(const vector<Komik *> &results, const string &message)
 {
-    cout << "\n\033[1;36m==============================================\033[0m" << endl;
-    cout << "\033[1;36m" << message << "\033[0m" << endl;
-    cout << "\033[1;36m==============================================\033[0m\n"
-         << endl;
+    TableRenderer table;
+
+    table.text("\n\033[1;36m==============================================\033[0m\n");
+    table.text("\033[1;36m" + message + "\033[0m\n");
+    table.text("\033[1;36m==============================================\033[0m\n\n");
 
     if (results.empty())
     {
-        cout << "\033[33mNo results found!\033[0m" << endl;
+        table.text("\033[33mNo results found!\033[0m\n");
     }
     else
     {
-        cout << "Found " << results.size() << " result(s):\n"
-             << endl;
-
-        // Print table header
-        cout << left << setw(5) << "ID"
-             << setw(30) << "Title"
-             << setw(25) << "Author"
-             << setw(20) << "Genre" << endl;
-        cout << string(80, '-') << endl;
+        table.text("Found ");
+        table.number(results.size());
+        table.text(" result(s):\n\n");
 
-        // Print results
+        table.komikHeader("Genre");
         for (const auto &comic : results)
         {
-            cout << left << setw(5) << comic->id
-                 << setw(30) << comic->title
-                 << setw(25) << comic->author
-                 << setw(20) << comic->genre << endl;
+            table.komikRow(comic);
+        }
+
+        table.text("\n\033[32mTotal: ");
+        table.number(results.size());
+        table.text(" comic(s)\033[0m\n");
+    }
+
+    table.text("\033[1;36m==============================================\033[0m\n\n");
+    table.flush();
+}
+
+// ===== DISPLAY RESULTS (CATALOG IMAGE) =====
+void SearchFilter::displayResults(const CatalogImage &image, const vector<size_t> &results, const string &message)
+{
+    TableRenderer table;
+
+    table.text("\n\033[1;36m==============================================\033[0m\n");
+    table.text("\033[1;36m" + message + "\033[0m\n");
+    table.text("\033[1;36m==============================================\033[0m\n\n");
+
+    if (results.empty())
+    {
+        table.text("\033[33mNo results found!\033[0m\n");
+    }
+    else
+    {
+        table.text("Found ");
+        table.number(results.size());
+        table.text(" result(s):\n\n");
+
+        table.komikHeader("Genre");
+
+        // String langsung dari mmap, tanpa copy ke std::string
+        CatalogEntry entry;
+        for (size_t index : results)
+        {
+            if (!image.getEntry(index, entry))
+                continue;
+
+            table.cell(entry.id)
+                .cell(entry.title, entry.titleLength)
+                .cell(entry.author, entry.authorLength)
+                .cell(entry.genre, entry.genreLength);
+            table.endRow();
         }
 
-        cout << "\n\033[32mTotal: " << results.size() << " comic(s)\033[0m" << endl;
+        table.text("\n\033[32mTotal: ");
+        table.number(results.size());
+        table.text(" comic(s)\033[0m\n");
     }
 
-    cout << "\033[1;36m==============================================\033[0m\n"
-         << endl;
-}
\ No newline at end of file
+    table.text("\033[1;36m==============================================\033[0m\n\n");
+    table.flush();
+}
@@ -0,0 +1,214 @@
+/*
+ * SlowQueryLog.cpp
+ * Slow query log berbasis sqlite3_trace_v2 dengan rotasi file
+ */
+
+#include "../include/SlowQueryLog.h"
+#include <iostream>
+#include <ctime>
+
+using namespace std;
+
+// Context trace per koneksi: log + label koneksi
+struct SlowQueryTrace
+{
+    SlowQueryLog *log;
+    const char *label;
+};
+
+// ===== CONSTRUCTOR / DESTRUCTOR =====
+SlowQueryLog::SlowQueryLog()
+    : file(nullptr), fileBytes(0), thresholdMs(50), maxBytes(1024 * 1024), maxFiles(3), logged(0)
+{
+}
+
+SlowQueryLog::~SlowQueryLog()
+{
+    close();
+    for (SlowQueryTrace *trace : traces)
+        delete trace;
+}
+
+bool SlowQueryLog::open(const string &logPath, double threshold, long bytes, int files)
+{
+    lock_guard<mutex> guard(m);
+    if (file)
+        fclose(file);
+
+    path = logPath;
+    thresholdMs = threshold;
+    maxBytes = bytes;
+    maxFiles = files;
+
+    file = fopen(path.c_str(), "ab");
+    if (!file)
+    {
+        cerr << "Cannot open slow query log: " << path << endl;
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    fileBytes = ftell(file);
+    return true;
+}
+
+void SlowQueryLog::close()
+{
+    lock_guard<mutex> guard(m);
+    if (file)
+    {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+// ===== TRACE =====
+
+void SlowQueryLog::attach(sqlite3 *conn, const char *label)
+{
+    if (!conn)
+        return;
+
+    SlowQueryTrace *trace = new SlowQueryTrace;
+    trace->log = this;
+    trace->label = label;
+    {
+        lock_guard<mutex> guard(m);
+        traces.push_back(trace);
+    }
+    sqlite3_trace_v2(conn, SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE, traceCallback, trace);
+}
+
+void SlowQueryLog::detach(sqlite3 *conn)
+{
+    if (conn)
+        sqlite3_trace_v2(conn, 0, nullptr, nullptr);
+}
+
+// STMT: statement mulai dijalankan (step pertama). PROFILE: statement
+// selesai (reset / finalize), X = waktu versi SQLite dalam ns.
+int SlowQueryLog::traceCallback(unsigned type, void *context, void *statement, void *extra)
+{
+    SlowQueryTrace *trace = (SlowQueryTrace *)context;
+    sqlite3_stmt *stmt = (sqlite3_stmt *)statement;
+
+    if (type == SQLITE_TRACE_STMT)
+        trace->log->begin(stmt);
+    else if (type == SQLITE_TRACE_PROFILE)
+        trace->log->finish(stmt, *(sqlite3_int64 *)extra, trace->label);
+    return 0;
+}
+
+void SlowQueryLog::begin(sqlite3_stmt *stmt)
+{
+    Running entry;
+    entry.start = chrono::steady_clock::now();
+    entry.totalChanges = sqlite3_total_changes(sqlite3_db_handle(stmt));
+
+    // STMT juga dipanggil untuk trigger; yang pertama yang dipakai
+    lock_guard<mutex> guard(m);
+    running.insert(make_pair(stmt, entry));
+}
+
+void SlowQueryLog::finish(sqlite3_stmt *stmt, long long sqliteNs, const char *connection)
+{
+    double ms = sqliteNs / 1e6;
+    int changes = -1;
+    {
+        lock_guard<mutex> guard(m);
+        unordered_map<sqlite3_stmt *, Running>::iterator it = running.find(stmt);
+        if (it != running.end())
+        {
+            ms = chrono::duration<double, milli>(chrono::steady_clock::now() - it->second.start).count();
+            changes = sqlite3_total_changes(sqlite3_db_handle(stmt)) - it->second.totalChanges;
+            running.erase(it);
+        }
+    }
+
+    if (ms < thresholdMs)
+        return;
+
+    // Statement write: jumlah row yang diubah. Statement read: langkah full
+    // scan + sort (indikasi index tidak terpakai) dan total VM step.
+    char stats[128];
+    if (sqlite3_stmt_readonly(stmt))
+    {
+        snprintf(stats, sizeof(stats), "scan_steps=%d sorts=%d vm_steps=%d",
+                 sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0),
+                 sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 0),
+                 sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, 0));
+    }
+    else
+    {
+        snprintf(stats, sizeof(stats), "rows_changed=%d", changes >= 0 ? changes : sqlite3_changes(sqlite3_db_handle(stmt)));
+    }
+
+    char *expanded = sqlite3_expanded_sql(stmt);
+    string sql = expanded ? expanded : sqlite3_sql(stmt);
+    sqlite3_free(expanded);
+
+    // Satu statement = satu baris
+    for (char &c : sql)
+    {
+        if (c == '\n' || c == '\r' || c == '\t')
+            c = ' ';
+    }
+
+    time_t now = time(nullptr);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+
+    char head[256];
+    int headLength = snprintf(head, sizeof(head), "%s | %9.3f ms | %-6s | %s | ", stamp, ms, connection, stats);
+
+    lock_guard<mutex> guard(m);
+    if (!file)
+        return;
+
+    fwrite(head, 1, headLength, file);
+    fwrite(sql.data(), 1, sql.size(), file);
+    fputc('\n', file);
+    fflush(file);
+
+    fileBytes += headLength + (long)sql.size() + 1;
+    logged++;
+
+    if (fileBytes >= maxBytes)
+        rotate();
+}
+
+// ===== ROTATION =====
+// Dipanggil dengan mutex terpegang
+void SlowQueryLog::rotate()
+{
+    fclose(file);
+    file = nullptr;
+
+    if (maxFiles > 0)
+    {
+        string oldest = path + "." + to_string(maxFiles);
+        remove(oldest.c_str());
+        for (int i = maxFiles - 1; i >= 1; i--)
+        {
+            string from = path + "." + to_string(i);
+            string to = path + "." + to_string(i + 1);
+            rename(from.c_str(), to.c_str());
+        }
+        rename(path.c_str(), (path + ".1").c_str());
+    }
+    else
+    {
+        remove(path.c_str());
+    }
+
+    file = fopen(path.c_str(), "ab");
+    fileBytes = 0;
+    if (!file)
+        cerr << "Cannot reopen slow query log: " << path << endl;
+}
+
+unsigned long long SlowQueryLog::getLoggedCount()
+{
+    lock_guard<mutex> guard(m);
+    return logged;
+}
@@ -0,0 +1,243 @@
+/*
+ * Snapshot.cpp
+ * Binary snapshot tree untuk startup cepat tanpa replay dari SQLite
+ */
+
+#include "../include/Snapshot.h"
+#include "../include/MappedFile.h"
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+// ===== CHECKSUM (FNV-1a 64-bit) =====
+// seed = hasil checksum sebelumnya, supaya bisa di-hash per bagian
+uint64_t Snapshot::checksum(const char *data, size_t length, uint64_t seed)
+{
+    uint64_t hash = seed;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool Snapshot::readString(const char *pool, uint64_t poolSize, uint32_t offset,
+                          const char *&str, uint32_t &length)
+{
+    if ((uint64_t)offset + sizeof(uint32_t) > poolSize)
+        return false;
+
+    memcpy(&length, pool + offset, sizeof(uint32_t));
+
+    if ((uint64_t)offset + sizeof(uint32_t) + length > poolSize)
+        return false;
+
+    str = pool + offset + sizeof(uint32_t);
+    return true;
+}
+
+// ===== VALIDASI HEADER =====
+bool Snapshot::readHeader(const char *data, uint64_t fileSize, SnapshotHeader &header, string &error)
+{
+    if (fileSize < sizeof(SnapshotHeader))
+    {
+        error = "file too small";
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION)
+    {
+        error = "unknown format/version";
+        return false;
+    }
+
+    // nodeCount dari file tidak dipercaya: cek batas dulu supaya perkalian tidak wrap
+    uint64_t available = fileSize - sizeof(SnapshotHeader);
+    if (header.nodeCount > available / sizeof(SnapshotRecord))
+    {
+        error = "size mismatch";
+        return false;
+    }
+
+    uint64_t recordSize = header.nodeCount * sizeof(SnapshotRecord);
+    if (header.poolSize != available - recordSize)
+    {
+        error = "size mismatch";
+        return false;
+    }
+
+    return true;
+}
+
+// ===== SAVE =====
+bool Snapshot::save(const string &path, const BST &tree, Database &db)
+{
+    vector<Komik *> komiks = tree.getAllKomiks();
+
+    // Fingerprint dari tree harus sama dengan database (database = source of truth).
+    // Kalau beda (misal ada komik yang belum tersimpan), jangan tulis snapshot.
+    TableFingerprint dbFp = db.getKomiksFingerprint();
+    long long maxId = 0, payloadBytes = 0;
+    for (Komik *k : komiks)
+    {
+        if (k->id > maxId)
+            maxId = k->id;
+        payloadBytes += k->title.size() + k->author.size() + k->genre.size();
+    }
+
+    if (dbFp.rowCount != (long long)komiks.size() || dbFp.maxId != maxId || dbFp.payloadBytes != payloadBytes)
+    {
+        cerr << "Snapshot skipped: tree is not in sync with database." << endl;
+        remove(path.c_str());
+        return false;
+    }
+
+    // Build string pool + records
+    string pool;
+    map<string, uint32_t> pooled;
+    vector<SnapshotRecord> records;
+    records.reserve(komiks.size());
+
+    auto intern = [&pool, &pooled](const string &value) -> uint32_t
+    {
+        auto it = pooled.find(value);
+        if (it != pooled.end())
+            return it->second;
+
+        uint32_t offset = (uint32_t)pool.size();
+        uint32_t length = (uint32_t)value.size();
+        pool.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        pool.append(value);
+        pooled[value] = offset;
+        return offset;
+    };
+
+    for (Komik *k : komiks)
+    {
+        SnapshotRecord rec;
+        rec.id = k->id;
+        rec.titleOffset = intern(k->title);
+        rec.authorOffset = intern(k->author);
+        rec.genreOffset = intern(k->genre);
+        records.push_back(rec);
+    }
+
+    const char *recordBytes = reinterpret_cast<const char *>(records.data());
+    size_t recordSize = records.size() * sizeof(SnapshotRecord);
+
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.nodeCount = records.size();
+    header.poolSize = pool.size();
+    header.checksum = checksum(pool.data(), pool.size(), checksum(recordBytes, recordSize));
+    header.dbRowCount = dbFp.rowCount;
+    header.dbMaxId = dbFp.maxId;
+    header.dbPayloadBytes = dbFp.payloadBytes;
+    header.dbChangeCounter = dbFp.fileChangeCounter;
+
+    // Tulis ke file sementara dulu, lalu rename (supaya tidak ada snapshot setengah jadi)
+    string tmpPath = path + ".tmp";
+    {
+        ofstream out(tmpPath.c_str(), ios::binary | ios::trunc);
+        if (!out)
+        {
+            cerr << "Failed to write snapshot: " << tmpPath << endl;
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(recordBytes, recordSize);
+        out.write(pool.data(), pool.size());
+
+        if (!out)
+        {
+            cerr << "Failed to write snapshot: " << tmpPath << endl;
+            return false;
+        }
+    }
+
+    remove(path.c_str());
+    if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        cerr << "Failed to replace snapshot: " << path << endl;
+        return false;
+    }
+
+    cout << "Snapshot saved: " << records.size() << " comics -> " << path << endl;
+    return true;
+}
+
+// ===== LOAD =====
+bool Snapshot::load(const string &path, BST &tree, Database &db)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+
+    // Validasi sama dengan CatalogImage::open (nodeCount dibatasi ukuran file)
+    SnapshotHeader header;
+    string error;
+    if (!readHeader(file.getData(), file.size(), header, error))
+    {
+        cerr << "Snapshot ignored: " << error << "." << endl;
+        return false;
+    }
+
+    uint64_t recordSize = header.nodeCount * sizeof(SnapshotRecord);
+
+    // Cek snapshot masih sesuai dengan database
+    TableFingerprint dbFp = db.getKomiksFingerprint();
+    if (dbFp.rowCount != header.dbRowCount || dbFp.maxId != header.dbMaxId ||
+        dbFp.payloadBytes != header.dbPayloadBytes || dbFp.fileChangeCounter != header.dbChangeCounter)
+    {
+        cout << "Snapshot is stale, loading from database instead." << endl;
+        return false;
+    }
+
+    const char *payload = file.getData() + sizeof(SnapshotHeader);
+    if (checksum(payload, recordSize + header.poolSize) != header.checksum)
+    {
+        cerr << "Snapshot ignored: checksum mismatch." << endl;
+        return false;
+    }
+
+    const char *pool = payload + recordSize;
+    vector<Komik *> komiks;
+    komiks.reserve(header.nodeCount);
+
+    for (uint64_t i = 0; i < header.nodeCount; i++)
+    {
+        SnapshotRecord rec;
+        memcpy(&rec, payload + i * sizeof(SnapshotRecord), sizeof(rec));
+
+        const char *title, *author, *genre;
+        uint32_t titleLen, authorLen, genreLen;
+
+        if (!readString(pool, header.poolSize, rec.titleOffset, title, titleLen) ||
+            !readString(pool, header.poolSize, rec.authorOffset, author, authorLen) ||
+            !readString(pool, header.poolSize, rec.genreOffset, genre, genreLen))
+        {
+            cerr << "Snapshot ignored: corrupt string pool." << endl;
+            for (Komik *k : komiks)
+                delete k;
+            return false;
+        }
+
+        komiks.push_back(new Komik(rec.id, string(title, titleLen), string(author, authorLen), string(genre, genreLen)));
+    }
+
+    tree.buildBalanced(komiks);
+
+    cout << "Loaded " << komiks.size() << " comics from snapshot." << endl;
+    return true;
+}
@@ -0,0 +1,158 @@
+/*
+ * TableRenderer.cpp
+ * Buffered table rendering, satu kali flush per layar
+ */
+
+#include "../include/TableRenderer.h"
+
+using namespace std;
+
+// ===== CONSTRUCTOR =====
+TableRenderer::TableRenderer(ostream &output)
+    : out(&output), column(0), autoFlushBytes(256 * 1024)
+{
+    buffer.reserve(16 * 1024);
+}
+
+// ===== DESTRUCTOR =====
+TableRenderer::~TableRenderer()
+{
+    flush();
+}
+
+void TableRenderer::setColumns(const vector<int> &columnWidths)
+{
+    widths = columnWidths;
+    column = 0;
+}
+
+// Tambah spasi sampai lebar kolom (teks yang lebih panjang tidak dipotong, sama seperti setw)
+void TableRenderer::pad(size_t written)
+{
+    if (column < widths.size() && (int)written < widths[column])
+    {
+        buffer.append(widths[column] - written, ' ');
+    }
+    column++;
+}
+
+// Output yang sangat panjang (misal traversal semua node) tetap ditulis per blok besar
+void TableRenderer::maybeFlush()
+{
+    if (buffer.size() >= autoFlushBytes)
+    {
+        out->write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+TableRenderer &TableRenderer::cell(const string &text)
+{
+    return cell(text.data(), text.size());
+}
+
+TableRenderer &TableRenderer::cell(const char *text, size_t length)
+{
+    buffer.append(text, length);
+    pad(length);
+    return *this;
+}
+
+TableRenderer &TableRenderer::cell(long long value)
+{
+    size_t before = buffer.size();
+    number(value);
+    pad(buffer.size() - before);
+    return *this;
+}
+
+void TableRenderer::endRow()
+{
+    buffer += '\n';
+    column = 0;
+    maybeFlush();
+}
+
+void TableRenderer::headerRow(const vector<string> &names)
+{
+    for (const string &name : names)
+    {
+        cell(name);
+    }
+    endRow();
+}
+
+void TableRenderer::separator(int width, char c)
+{
+    buffer.append(width, c);
+    buffer += '\n';
+}
+
+void TableRenderer::text(const string &str)
+{
+    buffer += str;
+    maybeFlush();
+}
+
+// Integer -> teks tanpa stringstream
+void TableRenderer::number(long long value)
+{
+    char digits[24];
+    int length = 0;
+    bool negative = value < 0;
+    unsigned long long v = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    do
+    {
+        digits[length++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+
+    if (negative)
+        buffer += '-';
+    while (length > 0)
+        buffer += digits[--length];
+}
+
+void TableRenderer::komikHeader(const string &genreLabel)
+{
+    setColumns({5, 30, 25, 20});
+    headerRow({"ID", "Title", "Author", genreLabel});
+    separator(80);
+}
+
+void TableRenderer::komikRow(const Komik *comic)
+{
+    cell(comic->id).cell(comic->title).cell(comic->author).cell(comic->genre);
+    endRow();
+}
+
+void TableRenderer::komikLine(const Komik *comic)
+{
+    buffer += "ID: ";
+    number(comic->id);
+    buffer += " | Title: ";
+    buffer += comic->title;
+    buffer += " | Author: ";
+    buffer += comic->author;
+    buffer += " | Genre: ";
+    buffer += comic->genre;
+    buffer += '\n';
+    maybeFlush();
+}
+
+void TableRenderer::flush()
+{
+    if (!buffer.empty())
+    {
+        out->write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+    out->flush();
+}
+
+void TableRenderer::clear()
+{
+    buffer.clear();
+    column = 0;
+}
@@ -0,0 +1,406 @@
+/*
+ * WriteBehindQueue.cpp
+ * Background writer: coalescing + group commit ke SQLite
+ */
+
+#include "../include/WriteBehindQueue.h"
+#include "../include/Metrics.h"
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+
+// SQLITE_BUSY: BEGIN/COMMIT dicoba lagi (busy_timeout 5 detik per percobaan),
+// batch yang tetap tidak bisa ditulis diantre ulang, bukan dibuang
+const int COMMIT_BUSY_RETRIES = 3;
+const int BUSY_BACKOFF_MS = 50;
+// Saat shutdown batch yang terus BUSY akhirnya dibuang supaya stop() selesai
+const int STOP_REQUEUE_LIMIT = 5;
+
+// ===== WRITE RECORD =====
+
+WriteRecord &WriteRecord::bind(long long value)
+{
+    WriteParam param;
+    param.isText = false;
+    param.number = value;
+    params.push_back(param);
+    return *this;
+}
+
+WriteRecord &WriteRecord::bind(const string &value)
+{
+    WriteParam param;
+    param.isText = true;
+    param.number = 0;
+    param.text = value;
+    params.push_back(param);
+    return *this;
+}
+
+bool WriteRecord::apply(sqlite3 *conn, string &error) const
+{
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        error = sqlite3_errmsg(conn);
+        return false;
+    }
+
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        if (params[i].isText)
+            sqlite3_bind_text(stmt, i + 1, params[i].text.c_str(), -1, SQLITE_TRANSIENT);
+        else
+            sqlite3_bind_int64(stmt, i + 1, params[i].number);
+    }
+
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE)
+    {
+        error = sqlite3_errmsg(conn);
+        return false;
+    }
+    return true;
+}
+
+// ===== CONSTRUCTOR =====
+WriteBehindQueue::WriteBehindQueue()
+    : conn(nullptr), slowLog(nullptr), nextSeq(0), committedSeq(0), running(false), stopping(false),
+      flushRequested(false), durableAck(false), intervalMs(5), batches(0), applied(0), coalesced(0), discarded(0),
+      discardedReported(0) {}
+
+// ===== DESTRUCTOR =====
+WriteBehindQueue::~WriteBehindQueue()
+{
+    stop();
+}
+
+bool WriteBehindQueue::start(const string &path, int interval, bool durable)
+{
+    if (running)
+        return true;
+
+    if (sqlite3_open(path.c_str(), &conn) != SQLITE_OK)
+    {
+        cerr << "Cannot open writer connection: " << sqlite3_errmsg(conn) << endl;
+        sqlite3_close(conn);
+        conn = nullptr;
+        return false;
+    }
+    sqlite3_busy_timeout(conn, 5000);
+    if (slowLog)
+        slowLog->attach(conn, "writer");
+
+    intervalMs = interval > 0 ? interval : 1;
+    durableAck = durable;
+    stopping = false;
+    running = true;
+    worker = thread(&WriteBehindQueue::run, this);
+    return true;
+}
+
+void WriteBehindQueue::setSlowQueryLog(SlowQueryLog *log)
+{
+    slowLog = log;
+    if (!running)
+        return;
+
+    // Koneksi writer sudah dibuka (mode serialized, aman dari thread lain)
+    if (slowLog)
+        slowLog->attach(conn, "writer");
+    else
+        SlowQueryLog::detach(conn);
+}
+
+void WriteBehindQueue::stop()
+{
+    if (!running)
+        return;
+
+    {
+        lock_guard<mutex> guard(m);
+        stopping = true;
+    }
+    workCv.notify_one();
+    worker.join();
+
+    sqlite3_close(conn);
+    conn = nullptr;
+    running = false;
+}
+
+// ===== SUBMIT (COALESCING) =====
+bool WriteBehindQueue::submit(WriteRecord record)
+{
+    unique_lock<mutex> guard(m);
+    record.seq = ++nextSeq;
+
+    map<string, size_t>::iterator it = pendingByKey.find(record.key);
+    if (it != pendingByKey.end())
+    {
+        WriteRecord &previous = pending[it->second];
+        bool replaces = record.kind == WRITE_DELETE ||
+                        (record.kind == WRITE_SET && previous.kind == WRITE_SET) ||
+                        (record.kind == WRITE_UPDATE && previous.kind == WRITE_UPDATE);
+
+        // Record lama tidak dijalankan; yang baru ditaruh di akhir supaya
+        // urutan terhadap mutation key lain tetap sesuai urutan terakhir
+        if (replaces)
+        {
+            previous.superseded = true;
+            coalesced++;
+        }
+    }
+
+    pendingByKey[record.key] = pending.size();
+    pending.push_back(record);
+    unsigned long long seq = record.seq;
+    guard.unlock();
+    workCv.notify_one();
+
+    if (!durableAck)
+        return true;
+
+    // Durable ack: tunggu sampai batch yang memuat record ini ter-commit
+    guard.lock();
+    doneCv.wait(guard, [this, seq]
+                { return committedSeq >= seq; });
+    return failedSeqs.erase(seq) == 0;
+}
+
+bool WriteBehindQueue::flush()
+{
+    if (!running)
+        return true;
+
+    unique_lock<mutex> guard(m);
+    unsigned long long target = nextSeq;
+    if (committedSeq < target)
+    {
+        flushRequested = true;
+        workCv.notify_one();
+        doneCv.wait(guard, [this, target]
+                    { return committedSeq >= target; });
+    }
+
+    // Durable ack: record yang gagal sudah dilaporkan ke pemanggil submit()
+    bool clean = durableAck || discarded == discardedReported;
+    discardedReported = discarded;
+    return clean;
+}
+
+long long WriteBehindQueue::getBatchCount() const
+{
+    lock_guard<mutex> guard(m);
+    return batches;
+}
+
+long long WriteBehindQueue::getAppliedCount() const
+{
+    lock_guard<mutex> guard(m);
+    return applied;
+}
+
+long long WriteBehindQueue::getCoalescedCount() const
+{
+    lock_guard<mutex> guard(m);
+    return coalesced;
+}
+
+long long WriteBehindQueue::getDiscardedCount() const
+{
+    lock_guard<mutex> guard(m);
+    return discarded;
+}
+
+string WriteBehindQueue::getLastError() const
+{
+    lock_guard<mutex> guard(m);
+    return lastError;
+}
+
+// ===== BACKGROUND THREAD =====
+void WriteBehindQueue::run()
+{
+    unique_lock<mutex> guard(m);
+    int busyRetries = 0;
+
+    while (true)
+    {
+        workCv.wait(guard, [this]
+                    { return !pending.empty() || stopping; });
+
+        if (pending.empty() && stopping)
+            break;
+
+        // Group commit window: kumpulkan mutation lain selama beberapa ms,
+        // kecuali ada yang menunggu (flush / shutdown). Pada durable ack tidak
+        // ada window: batch berikutnya terbentuk dari yang antre selama commit.
+        if (!durableAck && !flushRequested && !stopping)
+        {
+            workCv.wait_for(guard, chrono::milliseconds(intervalMs), [this]
+                            { return flushRequested || stopping; });
+        }
+
+        vector<WriteRecord> batch;
+        batch.swap(pending);
+        pendingByKey.clear();
+        flushRequested = false;
+        unsigned long long batchSeq = nextSeq;
+
+        guard.unlock();
+        bool done = commitBatch(batch);
+        guard.lock();
+
+        if (!done && !(stopping && busyRetries >= STOP_REQUEUE_LIMIT))
+        {
+            // Database sibuk: batch kembali ke depan antrean, committedSeq tidak
+            // maju sehingga flush / durable ack tetap menunggu
+            requeue(batch);
+            busyRetries++;
+            workCv.wait_for(guard, chrono::milliseconds(BUSY_BACKOFF_MS));
+            continue;
+        }
+
+        if (!done)
+        {
+            long long lost = 0;
+            for (const WriteRecord &record : batch)
+            {
+                if (!record.superseded)
+                {
+                    lost++;
+                    if (durableAck)
+                        failedSeqs.insert(record.seq);
+                }
+            }
+            discarded += lost;
+            lastError = "database busy at shutdown";
+            cerr << "Write-behind: " << lost << " write(s) discarded, database busy at shutdown" << endl;
+        }
+
+        busyRetries = 0;
+        committedSeq = batchSeq;
+        doneCv.notify_all();
+    }
+}
+
+void WriteBehindQueue::requeue(vector<WriteRecord> &batch)
+{
+    // Urutan asli dipertahankan: batch lama dulu, lalu yang masuk selama commit
+    vector<WriteRecord> merged;
+    merged.reserve(batch.size() + pending.size());
+    for (WriteRecord &record : batch)
+    {
+        if (!record.superseded)
+            merged.push_back(record);
+    }
+    for (WriteRecord &record : pending)
+        merged.push_back(record);
+
+    pending.swap(merged);
+    pendingByKey.clear();
+    for (size_t i = 0; i < pending.size(); i++)
+        pendingByKey[pending[i].key] = i;
+}
+
+static bool isBusy(int rc)
+{
+    return (rc & 0xff) == SQLITE_BUSY || (rc & 0xff) == SQLITE_LOCKED;
+}
+
+bool WriteBehindQueue::commitBatch(vector<WriteRecord> &batch)
+{
+    METRIC_TIMER("db.writeBehind.commit");
+    char *errMsg = nullptr;
+    string batchError;
+
+    int rc = sqlite3_exec(conn, "BEGIN IMMEDIATE;", nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK)
+    {
+        batchError = errMsg ? errMsg : sqlite3_errmsg(conn);
+        sqlite3_free(errMsg);
+        errMsg = nullptr;
+
+        // Tanpa transaction record tidak boleh dijalankan (autocommit per row)
+        cerr << "Write-behind BEGIN failed: " << batchError << endl;
+        if (isBusy(rc))
+            return false;
+    }
+
+    vector<unsigned long long> failed;
+    string error;
+    long long count = 0;
+
+    if (batchError.empty())
+    {
+        for (const WriteRecord &record : batch)
+        {
+            if (record.superseded)
+                continue;
+
+            if (!record.apply(conn, error))
+            {
+                cerr << record.errorLabel << ": " << error << endl;
+                failed.push_back(record.seq);
+                batchError = error;
+                continue;
+            }
+            count++;
+        }
+
+        // COMMIT yang BUSY boleh diulang, transaction tetap aktif
+        rc = sqlite3_exec(conn, "COMMIT;", nullptr, nullptr, &errMsg);
+        for (int attempt = 0; isBusy(rc) && attempt < COMMIT_BUSY_RETRIES; attempt++)
+        {
+            sqlite3_free(errMsg);
+            errMsg = nullptr;
+            this_thread::sleep_for(chrono::milliseconds(BUSY_BACKOFF_MS));
+            rc = sqlite3_exec(conn, "COMMIT;", nullptr, nullptr, &errMsg);
+        }
+
+        if (rc != SQLITE_OK)
+        {
+            string commitError = errMsg ? errMsg : sqlite3_errmsg(conn);
+            sqlite3_free(errMsg);
+            cerr << "Write-behind COMMIT failed: " << commitError << endl;
+            sqlite3_exec(conn, "ROLLBACK;", nullptr, nullptr, nullptr);
+
+            // Masih BUSY: belum ada yang tersimpan, seluruh batch dicoba lagi
+            if (isBusy(rc))
+                return false;
+
+            batchError = commitError;
+            failed.clear();
+            count = 0;
+        }
+    }
+
+    // BEGIN / COMMIT gagal (bukan BUSY): seluruh batch dibuang
+    if (count == 0 && !batchError.empty())
+    {
+        failed.clear();
+        for (const WriteRecord &record : batch)
+        {
+            if (!record.superseded)
+                failed.push_back(record.seq);
+        }
+    }
+
+    METRIC_ADD("db.writeBehind.records", count);
+
+    lock_guard<mutex> guard(m);
+    batches++;
+    applied += count;
+    if (!failed.empty())
+    {
+        discarded += (long long)failed.size();
+        lastError = batchError;
+    }
+    if (durableAck)
+        failedSeqs.insert(failed.begin(), failed.end());
+    return true;
+}